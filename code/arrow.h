@@ -4,18 +4,17 @@
 #include <limits>
 
 #include "game_object.h"
+#include "kd_tree.h"
 
 namespace game {
 
 	class Arrow : public GameObject {
 	
 	public:
-		Arrow(const glm::vec3& position, Geometry* geom, Shader* shader, GLuint texture, GameObject* player,
-			GameObject** win_1, GameObject** win_2, GameObject** win_3, GameObject** win_4);
+		// points from player to the nearest object in win_tree, which the game rebuilds every frame
+		Arrow(const glm::vec3& position, Geometry* geom, Shader* shader, GLuint texture, GameObject* player, const KdTree* win_tree);
 		~Arrow();
 
-		void Render(glm::mat4 view_matrix, double current_time) override;
-
 		void Update(double delta_time) override;
 
 		// Getters
@@ -26,7 +25,7 @@ namespace game {
 
 		glm::vec3 model_position;
 
-		std::vector<GameObject**> win_collectibles;
+		const KdTree* win_tree;
 	};
 
 }
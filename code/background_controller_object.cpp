@@ -84,7 +84,7 @@ void BackgroundControllerObject::Update(double delta_time) {
 }
 
 
-void BackgroundControllerObject::Render(glm::mat4 view_matrix, double current_time) {
+void BackgroundControllerObject::Render(double current_time) {
 	for (int i = 0; i < tiles_.size(); i++) {
 		
 		// if player is within render_distance, tiles are rendered
@@ -92,7 +92,7 @@ void BackgroundControllerObject::Render(glm::mat4 view_matrix, double current_ti
 		target_position.z = 0.0f;
 		float distance = glm::length(target_position - player->GetPosition());
 		if (distance <= render_distance) {
-			tiles_[i]->Render(view_matrix, current_time);
+			tiles_[i]->Render(current_time);
 		}
 	}
 }
@@ -21,7 +21,7 @@ namespace game {
 
 		void Update(double delta_time) override;
 
-		void Render(glm::mat4 view_matrix, double current_time) override;
+		void Render(double current_time) override;
 
 		// helpers
 		bool inSet(std::set<std::pair<float, float>> s, float x, float y);
@@ -3,6 +3,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "background_sprite.h"
+#include "gl_state.h"
 
 namespace game {
 
@@ -40,12 +41,12 @@ void BackgroundSprite::CreateGeometry(void){
 
     // Create buffer for vertices
     glGenBuffers(1, &vbo_);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, vbo_);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertex), vertex, GL_STATIC_DRAW);
 
     // Create buffer for faces (index buffer)
     glGenBuffers(1, &ebo_);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+    GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(face), face, GL_STATIC_DRAW);
 
     // Set number of elements in array buffer (6 in this case)
@@ -57,13 +58,13 @@ void BackgroundSprite::SetGeometry(GLuint shader_program)
 {
 
     // No blending
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-    glDisable(GL_BLEND);
+    GLState::SetDepthTest(true);
+    GLState::SetDepthFunc(GL_LESS);
+    GLState::SetBlend(false);
 
     // Bind buffers
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, vbo_);
+    GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
 
     // Set attributes for shaders
     // Should be consistent with how we created the buffers for the square
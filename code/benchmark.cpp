@@ -0,0 +1,775 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <path_config.h>
+
+#include "benchmark.h"
+#include "simd.h"
+#include "camera_buffer.h"
+#include "collision_handler.h"
+#include "enemy_steering.h"
+#include "explosion_pool.h"
+#include "feedback_particle_system.h"
+#include "game_object.h"
+#include "gl_state.h"
+#include "gl_stats.h"
+#include "kd_tree.h"
+#include "particle_simulator.h"
+#include "particle_system.h"
+#include "particle_target.h"
+#include "particles.h"
+#include "projectile_system.h"
+#include "ranged_enemy_object.h"
+#include "shader_cache.h"
+#include "sprite.h"
+#include "transform2d.h"
+#include "transform_stream.h"
+
+namespace game {
+
+void Benchmark::RunAll(void)
+{
+    std::cout << "SIMD width: " << SIMD_WIDTH << " lanes" << std::endl;
+
+    EnemySteering(MAX_ENEMY_COUNT, 1000);
+    EnemySteering(10000, 100);
+
+    Projectiles(1000, MAX_ENEMY_COUNT, 100);
+    Projectiles(20000, MAX_ENEMY_COUNT, 100);
+
+    Particles(1000, 300);
+    Particles(10000, 300);
+    Particles(MAX_SIMULATED_PARTICLES, 300);
+
+    Transforms(1000, 1000);
+    Transforms(20000, 100);
+}
+
+
+void Benchmark::RunOpenGL(void)
+{
+    // a hidden window is enough for a context, rendering goes to its back buffer
+    if (!glfwInit()) {
+        std::cout << "OpenGL benchmarks skipped: could not initialize GLFW" << std::endl;
+        return;
+    }
+    glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+    GLFWwindow* window = glfwCreateWindow(800, 600, "Benchmark", NULL, NULL);
+    if (!window) {
+        std::cout << "OpenGL benchmarks skipped: could not create a window" << std::endl;
+        glfwTerminate();
+        return;
+    }
+    glfwMakeContextCurrent(window);
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK) {
+        std::cout << "OpenGL benchmarks skipped: could not initialize GLEW" << std::endl;
+        glfwTerminate();
+        return;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << ", OpenGL " << glGetString(GL_VERSION) << std::endl;
+
+    ParticleRendering(10000, 100);
+    ParticleRendering(MAX_SIMULATED_PARTICLES, 20);
+
+    ParticleFill(50, 2, 20);
+    ParticleFill(50, 4, 20);
+
+    StateCache(1000, 100);
+
+    TransformUpload(1000, 100);
+    TransformUpload(10000, 20);
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+}
+
+
+double Benchmark::ElapsedMilliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+void Benchmark::EnemySteering(int enemy_count, int frames)
+{
+    const double delta_time = 1.0 / 60.0;
+
+    // the same scene twice, one stepped per object and one through the batch
+    PlayerGameObject player(glm::vec3(0.0f, 0.0f, 0.0f), nullptr, nullptr, 0);
+    player.SetVelocity(glm::vec3(3.0f, -2.0f, 0.0f));
+
+    game::EnemySteering steering;
+    steering.setPlayer(&player);
+
+    std::vector<RangedEnemyObject*> scalar_enemies;
+    std::vector<RangedEnemyObject*> batched_enemies;
+    std::vector<glm::vec3> targets;
+    std::srand(2501);
+    for (int i = 0; i < enemy_count; i++) {
+        glm::vec3 position = Helper::generate2dPosition(-50.0f, 50.0f, -50.0f, 50.0f);
+        float angle = Helper::generateFloat(0.0f, 2 * glm::pi<float>());
+        targets.push_back(Helper::generate2dPosition(-50.0f, 50.0f, -50.0f, 50.0f));
+
+        RangedEnemyObject* scalar_enemy = new RangedEnemyObject(position, nullptr, nullptr, 0, &player, nullptr);
+        RangedEnemyObject* batched_enemy = new RangedEnemyObject(position, nullptr, nullptr, 0, &player, nullptr);
+        scalar_enemy->SetRotation(angle);
+        batched_enemy->SetRotation(angle);
+        batched_enemy->setSteering(&steering);
+        scalar_enemies.push_back(scalar_enemy);
+        batched_enemies.push_back(batched_enemy);
+    }
+
+    // move and turn
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        for (int i = 0; i < enemy_count; i++) {
+            scalar_enemies[i]->setTargetPosition(targets[i]);
+            scalar_enemies[i]->moveTowardsTarget(delta_time, i % 2 == 0);
+        }
+    }
+    double scalar_move_time = ElapsedMilliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        for (int i = 0; i < enemy_count; i++) {
+            batched_enemies[i]->setTargetPosition(targets[i]);
+            batched_enemies[i]->moveTowardsTarget(delta_time, i % 2 == 0);
+        }
+        steering.flush(delta_time);
+    }
+    double batched_move_time = ElapsedMilliseconds(start);
+
+    float max_position_error = 0.0f;
+    for (int i = 0; i < enemy_count; i++) {
+        max_position_error = std::max(max_position_error, glm::length(scalar_enemies[i]->GetPosition() - batched_enemies[i]->GetPosition()));
+    }
+
+    // intercept aim
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        for (int i = 0; i < enemy_count; i++) {
+            scalar_enemies[i]->aimAtPlayer(delta_time, 20.0f, 0.0f);
+        }
+    }
+    double scalar_aim_time = ElapsedMilliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        for (int i = 0; i < enemy_count; i++) {
+            batched_enemies[i]->aimAtPlayer(delta_time, 20.0f, 0.0f);
+        }
+        steering.flush(delta_time);
+    }
+    double batched_aim_time = ElapsedMilliseconds(start);
+
+    float max_angle_error = 0.0f;
+    for (int i = 0; i < enemy_count; i++) {
+        float difference = Helper::normalizeAngle(scalar_enemies[i]->GetRotation() - batched_enemies[i]->GetRotation());
+        max_angle_error = std::max(max_angle_error, std::abs(difference));
+    }
+
+    // kernels alone, without gathering from and scattering to the game objects
+    SteeringLanes lanes;
+    lanes.resize(simd::padded(enemy_count));
+    for (int i = 0; i < enemy_count; i++) {
+        lanes.position_x[i] = batched_enemies[i]->GetPosition().x;
+        lanes.position_y[i] = batched_enemies[i]->GetPosition().y;
+        lanes.angle[i] = batched_enemies[i]->GetRotation();
+        lanes.target_x[i] = targets[i].x;
+        lanes.target_y[i] = targets[i].y;
+        lanes.speed[i] = batched_enemies[i]->getSpeed();
+        lanes.turn_speed[i] = batched_enemies[i]->getTurnSpeed();
+        lanes.stop_angle[i] = 0.001f;
+        lanes.move_enabled[i] = 1.0f;
+        lanes.aim_speed[i] = 20.0f;
+    }
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        game::EnemySteering::interceptBatch(lanes, enemy_count, glm::vec2(0.0f, 0.0f), glm::vec2(3.0f, -2.0f));
+        game::EnemySteering::steerBatch(lanes, enemy_count, static_cast<float>(delta_time));
+    }
+    double kernel_time = ElapsedMilliseconds(start);
+
+    // a batched ranged enemy already facing a standing player has to fire on its first engaged tick,
+    // the facing check is deferred to the flush and would otherwise never run
+    PlayerGameObject standing_player(glm::vec3(0.0f, 0.0f, 0.0f), nullptr, nullptr, 0);
+    game::EnemySteering fire_steering;
+    fire_steering.setPlayer(&standing_player);
+    std::vector<GameObject*> fired_bullets;
+    BulletObject enemy_bullet(glm::vec3(0.0f, 0.0f, 0.0f), nullptr, nullptr, 0, 10.0f, glm::vec3(1.0f, 0.0f, 0.0f), 20.0f, 2.0f, 0.1f, BulletType::NORMAL);
+    RangedEnemyObject* shooter = new RangedEnemyObject(glm::vec3(-8.0f, 0.0f, 0.0f), nullptr, nullptr, 0, &standing_player, &fired_bullets);
+    shooter->setBullets(&enemy_bullet);
+    shooter->setSteering(&fire_steering);
+    shooter->SetRotation(0.0f);
+    // the first tick only notices the player, the second one engages
+    for (int tick = 0; tick < 2 && fired_bullets.empty(); tick++) {
+        shooter->Update(delta_time);
+        fire_steering.flush(delta_time);
+    }
+    bool shooter_fired = !fired_bullets.empty();
+    delete shooter;
+    for (GameObject* fired_bullet : fired_bullets) {
+        delete fired_bullet;
+    }
+
+    std::cout << "Enemy steering, " << enemy_count << " enemies x " << frames << " frames" << std::endl;
+    std::cout << "  move  scalar " << scalar_move_time / frames << " ms/frame, batched " << batched_move_time / frames
+              << " ms/frame (" << scalar_move_time / batched_move_time << "x), max position error " << max_position_error << std::endl;
+    std::cout << "  aim   scalar " << scalar_aim_time / frames << " ms/frame, batched " << batched_aim_time / frames
+              << " ms/frame (" << scalar_aim_time / batched_aim_time << "x), max angle error " << max_angle_error << std::endl;
+    std::cout << "  aim + move kernels only " << kernel_time / frames << " ms/frame" << std::endl;
+    if (!shooter_fired) {
+        std::cout << "  batched ranged enemy facing the player did not fire" << std::endl;
+    }
+
+    for (int i = 0; i < enemy_count; i++) {
+        delete scalar_enemies[i];
+        delete batched_enemies[i];
+    }
+}
+
+
+void Benchmark::Projectiles(int bullet_count, int enemy_count, int frames)
+{
+    const double delta_time = 1.0 / 60.0;
+
+    // the player fires in every direction from the middle of a ring of enemies
+    PlayerGameObject player(glm::vec3(0.0f, 0.0f, 0.0f), nullptr, nullptr, 0);
+
+    std::vector<GameObject*> enemies;
+    std::srand(2501);
+    for (int i = 0; i < enemy_count; i++) {
+        glm::vec3 position = Helper::generate2dPosition(player.GetPosition(), 20.0f, 60.0f);
+        RangedEnemyObject* enemy = new RangedEnemyObject(position, nullptr, nullptr, 0, &player, nullptr);
+        enemy->setHealth(1.0e9f);
+        enemies.push_back(enemy);
+    }
+    KdTree enemy_tree;
+    enemy_tree.build(enemies);
+
+    BulletObject bullet(glm::vec3(0.0f, 0.0f, 0.0f), nullptr, nullptr, 0, 30.0f, glm::vec3(0.0f, 1.0f, 0.0f), 20.0f, 60.0f, 0.1f, BulletType::NORMAL);
+    bullet.SetScale(10.0f);
+
+    std::vector<glm::vec3> directions;
+    for (int i = 0; i < bullet_count; i++) {
+        float angle = Helper::generateFloat(0.0f, 2 * glm::pi<float>());
+        directions.push_back(glm::vec3(glm::cos(angle), glm::sin(angle), 0.0f));
+    }
+
+    // one object per bullet, updated and tested against every enemy like Game and CollisionHandler do
+    std::vector<GameObject*> bullet_objects;
+    BulletExpiryRing bullet_expiry_ring;
+    bullet_expiry_ring.setBullets(&bullet_objects);
+    bullet.SetExpiryRing(&bullet_expiry_ring);
+    for (int i = 0; i < bullet_count; i++) {
+        bullet.Fire(glm::vec3(0.0f, 0.0f, 0.0f), directions[i], 10.0f, &player, &bullet_objects);
+    }
+    CollisionHandler collision_handler;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        for (int i = 0; i < bullet_objects.size(); i++) {
+            bullet_objects[i]->Update(delta_time);
+        }
+        bullet_expiry_ring.Update(delta_time);
+        for (int i = 0; i < bullet_objects.size(); i++) {
+            BulletObject* current_bullet = static_cast<BulletObject*>(bullet_objects[i]);
+            if (collision_handler.checkBulletCollision(current_bullet, enemies, delta_time) != -1) {
+                bullet_expiry_ring.remove(current_bullet);
+                i--;
+            }
+        }
+    }
+    double object_time = ElapsedMilliseconds(start);
+    int object_survivors = static_cast<int>(bullet_objects.size());
+
+    // the same shots as packed data
+    ProjectileSystem projectiles;
+    projectiles.setUp(&enemies, &enemy_tree, nullptr);
+    bullet.SetProjectiles(&projectiles);
+    for (int i = 0; i < bullet_count; i++) {
+        bullet.Fire(glm::vec3(0.0f, 0.0f, 0.0f), directions[i], 10.0f, &player, nullptr);
+    }
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        projectiles.Update(delta_time);
+        projectiles.Collide(delta_time);
+    }
+    double packed_time = ElapsedMilliseconds(start);
+
+    std::cout << "Projectiles, " << bullet_count << " bullets, " << enemy_count << " enemies x " << frames << " frames" << std::endl;
+    std::cout << "  objects " << object_time / frames << " ms/frame, packed " << packed_time / frames
+              << " ms/frame (" << object_time / packed_time << "x), live after " << object_survivors << " vs " << projectiles.getCount() << std::endl;
+
+    for (int i = 0; i < bullet_objects.size(); i++) {
+        delete bullet_objects[i];
+    }
+    for (int i = 0; i < enemies.size(); i++) {
+        delete enemies[i];
+    }
+}
+
+
+void Benchmark::Particles(int particle_count, int frames)
+{
+    const double delta_time = 1.0 / 60.0;
+
+    // one emitter keeping particle_count alive: a burst to start, then a rate replacing the ones that die
+    ParticleEmitter emitter;
+    emitter.lifetime = 2.0f;
+    emitter.rate = particle_count / emitter.lifetime;
+    emitter.drag = 0.5f;
+    emitter.gravity = -9.8f;
+
+    // one struct per particle, updated and removed one by one
+    struct Particle {
+        glm::vec3 position;
+        glm::vec3 velocity;
+        float life;
+        float drag;
+        float gravity;
+    };
+    std::vector<Particle> particles;
+    std::srand(2501);
+    auto spawn = [&]() {
+        float angle = emitter.direction + Helper::generateFloat(-0.5f, 0.5f) * emitter.spread;
+        float speed = Helper::generateFloat(emitter.min_speed, emitter.max_speed);
+        particles.push_back({ emitter.position, glm::vec3(glm::cos(angle), glm::sin(angle), 0.0f) * speed, emitter.lifetime, emitter.drag, emitter.gravity });
+    };
+    for (int i = 0; i < particle_count; i++) {
+        spawn();
+    }
+    float accumulator = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        accumulator += emitter.rate * static_cast<float>(delta_time);
+        int owed = static_cast<int>(accumulator);
+        accumulator -= owed;
+        for (int i = 0; i < owed && particles.size() < MAX_SIMULATED_PARTICLES; i++) {
+            spawn();
+        }
+        for (int i = 0; i < particles.size(); i++) {
+            Particle& particle = particles[i];
+            particle.velocity *= glm::max(0.0f, 1.0f - particle.drag * static_cast<float>(delta_time));
+            particle.velocity.y += particle.gravity * static_cast<float>(delta_time);
+            particle.position += particle.velocity * static_cast<float>(delta_time);
+            particle.life -= static_cast<float>(delta_time);
+            if (particle.life <= 0.0f) {
+                particles[i] = particles.back();
+                particles.pop_back();
+                i--;
+            }
+        }
+    }
+    double scalar_time = ElapsedMilliseconds(start);
+
+    // the same particles as packed data
+    ParticleSimulator simulator;
+    std::srand(2501);
+    simulator.burst(emitter, particle_count);
+    simulator.addEmitter(emitter);
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        simulator.Update(delta_time);
+    }
+    double packed_time = ElapsedMilliseconds(start);
+
+    // the vertices Render streams each frame
+    std::vector<float> vertices;
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        simulator.buildVertices(&vertices);
+    }
+    double vertex_time = ElapsedMilliseconds(start);
+
+    std::cout << "Particles, " << particle_count << " particles x " << frames << " frames" << std::endl;
+    std::cout << "  structs " << scalar_time / frames << " ms/frame, packed " << packed_time / frames
+              << " ms/frame (" << scalar_time / packed_time << "x), live after " << particles.size() << " vs " << simulator.getCount() << std::endl;
+    std::cout << "  vertex stream " << vertex_time / frames << " ms/frame, " << vertices.size() * sizeof(float) / 1024 << " KiB" << std::endl;
+}
+
+
+void Benchmark::Transforms(int object_count, int frames)
+{
+    // objects spread around a zoomed out view, each inside the next one's transform like a particle system in its parent
+    std::vector<glm::vec3> positions(object_count);
+    std::vector<float> angles(object_count);
+    std::vector<glm::vec2> scales(object_count);
+    std::srand(2501);
+    for (int i = 0; i < object_count; i++) {
+        positions[i] = glm::vec3(Helper::generateFloat(-50.0f, 50.0f), Helper::generateFloat(-50.0f, 50.0f), Helper::generateFloat(0.0f, 5.0f));
+        angles[i] = Helper::generateFloat(0.0f, 2.0f * glm::pi<float>());
+        scales[i] = glm::vec2(Helper::generateFloat(0.5f, 3.0f), Helper::generateFloat(0.5f, 3.0f));
+    }
+    glm::mat4 view_matrix = glm::scale(glm::mat4(1.0f), glm::vec3(0.075f, 0.1f, 0.1f)) * glm::translate(glm::mat4(1.0f), glm::vec3(-3.0f, 2.0f, 0.0f));
+    glm::vec2 cursor(0.25f, -0.5f);
+
+    // one object in eight unprojects the cursor, like a turret
+    float matrix_sum = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        for (int i = 0; i < object_count; i++) {
+            int parent = (i + 1) % object_count;
+            glm::mat4 parent_matrix = glm::translate(glm::mat4(1.0f), positions[parent]) * glm::rotate(glm::mat4(1.0f), angles[parent], glm::vec3(0.0, 0.0, 1.0));
+            glm::mat4 transformation_matrix = parent_matrix * glm::translate(glm::mat4(1.0f), positions[i])
+                * glm::rotate(glm::mat4(1.0f), angles[i], glm::vec3(0.0, 0.0, 1.0)) * glm::scale(glm::mat4(1.0f), glm::vec3(scales[i].x, scales[i].y, 1.0));
+            matrix_sum += transformation_matrix[3][0];
+            if (i % 8 == 0) {
+                matrix_sum += (glm::inverse(view_matrix) * glm::vec4(cursor.x, cursor.y, 0.0f, 1.0f)).x;
+            }
+        }
+    }
+    double matrix_time = ElapsedMilliseconds(start);
+
+    float affine_sum = 0.0f;
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        Transform2D view = Transform2D::FromMat4(view_matrix);
+        for (int i = 0; i < object_count; i++) {
+            int parent = (i + 1) % object_count;
+            Transform2D transformation = Transform2D::Make(positions[parent], angles[parent], glm::vec2(1.0f)) * Transform2D::Make(positions[i], angles[i], scales[i]);
+            affine_sum += transformation.row_x.z;
+            if (i % 8 == 0) {
+                affine_sum += view.Inverse().Apply(cursor).x;
+            }
+        }
+    }
+    double affine_time = ElapsedMilliseconds(start);
+
+    // both have to place the objects in the same spot, up to rounding
+    bool same = std::abs(matrix_sum - affine_sum) <= 1e-3f * (std::abs(matrix_sum) + 1.0f);
+
+    std::cout << "Transforms, " << object_count << " objects x " << frames << " frames" << std::endl;
+    std::cout << "  glm::mat4 " << matrix_time * 1000.0 / frames << " us/frame, Transform2D " << affine_time * 1000.0 / frames
+              << " us/frame (" << matrix_time / affine_time << "x)" << (same ? "" : ", RESULTS DIFFER") << std::endl;
+}
+
+void Benchmark::ParticleRendering(int particle_count, int frames)
+{
+    const double delta_time = 1.0 / 60.0;
+    const std::string resources = RESOURCES_DIRECTORY;
+    glm::mat4 view_matrix = glm::scale(glm::mat4(1.0f), glm::vec3(0.1f, 0.1f, 0.1f));
+
+    CameraBuffer camera;
+    camera.Init();
+    camera.Update(view_matrix);
+
+    ShaderCache shaders;
+    shaders.Init(resources, &camera, nullptr);
+    Shader* particle_shader = shaders.Get("/particle_vertex_shader.glsl", "/particle_fragment_shader.glsl", { "EXPLOSION_PARTICLE" });
+    Shader* stream_shader = shaders.Get("/particle_stream_vertex_shader.glsl", "/particle_fragment_shader.glsl", { "EXPLOSION_PARTICLE" });
+
+    // every path draws the same particles: a whole number of explosion systems' worth, all quads of the same size
+    // spreading from the origin as fast as an explosion's do
+    const int system_particles = NUM_PARTICLES / 4;
+    const float quad_size = 0.2f;
+    const float explosion_speed = 0.7f;
+    particle_count -= particle_count % system_particles;
+
+    // a white texel, so no fragment is discarded
+    GLuint texture;
+    GLubyte white[] = { 255, 255, 255, 255 };
+    glGenTextures(1, &texture);
+    GLState::BindTexture(texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    // shader only: explosion systems animated by the vertex shader, scaled so their unit quads are quad_size across
+    game::Particles geometry;
+    geometry.CreateGeometry(1.0f, 0.0f, 0.0f, 5);
+    GameObject parent(glm::vec3(0.0f, 0.0f, 0.0f), nullptr, nullptr, 0);
+    std::vector<ParticleSystem*> systems;
+    for (int i = 0; i < particle_count; i += system_particles) {
+        systems.push_back(new ParticleSystem(glm::vec3(0.0f, 0.0f, 0.0f), &geometry, particle_shader, texture, &parent, EXPLOSION_PARTICLE, 5.0f, explosion_speed, 0.0f));
+        systems.back()->SetScale(quad_size);
+    }
+    glFinish();
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        for (int i = 0; i < systems.size(); i++) {
+            systems[i]->Update(delta_time);
+            systems[i]->Render(frame * delta_time);
+        }
+        glFinish();
+    }
+    double shader_time = ElapsedMilliseconds(start);
+
+    // the same particles for the simulated paths, alive for the whole run and moving up to the fastest explosion particle
+    // (Particles::CreateGeometry directions are up to 0.8 long, and the system's scale scales the motion too)
+    ParticleEmitter emitter;
+    emitter.lifetime = 1000.0f;
+    emitter.min_speed = 0.0f;
+    emitter.max_speed = 0.8f * explosion_speed * quad_size;
+    emitter.size = quad_size;
+
+    // simulated on the cpu, streamed every frame
+    ParticleSimulator simulator;
+    simulator.Init(stream_shader, texture);
+    simulator.burst(emitter, particle_count);
+    glFinish();
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        simulator.Update(delta_time);
+        simulator.Render();
+        glFinish();
+    }
+    double stream_time = ElapsedMilliseconds(start);
+
+    // simulated on the gpu with transform feedback, where the instanced draws it renders with are available
+    double feedback_time = -1.0;
+    if (GLEW_VERSION_3_3) {
+        Shader* feedback_shader = shaders.GetFeedback("/particle_feedback_vertex_shader.glsl", { "feedback_position", "feedback_velocity", "feedback_life", "feedback_properties" });
+        Shader* feedback_render_shader = shaders.Get("/particle_feedback_render_vertex_shader.glsl", "/particle_fragment_shader.glsl", { "EXPLOSION_PARTICLE" });
+        FeedbackParticleSystem feedback;
+        feedback.Init(feedback_shader, feedback_render_shader, texture);
+        feedback.burst(emitter, particle_count);
+        glFinish();
+        start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++) {
+            glClear(GL_COLOR_BUFFER_BIT);
+            feedback.Update(delta_time);
+            feedback.Render();
+            glFinish();
+        }
+        feedback_time = ElapsedMilliseconds(start);
+    }
+
+    std::cout << "Particle rendering, " << particle_count << " particles of " << quad_size << " units x " << frames << " frames" << std::endl;
+    std::cout << "  shader only " << shader_time / frames << " ms/frame (" << systems.size() << " draws), cpu stream "
+              << stream_time / frames << " ms/frame, transform feedback ";
+    if (feedback_time >= 0.0) {
+        std::cout << feedback_time / frames << " ms/frame" << std::endl;
+    } else {
+        std::cout << "needs OpenGL 3.3" << std::endl;
+    }
+
+    for (int i = 0; i < systems.size(); i++) {
+        delete systems[i];
+    }
+    GLState::DeleteTextures(1, &texture);
+}
+
+
+void Benchmark::ParticleFill(int explosion_count, int divisor, int frames)
+{
+    const double delta_time = 1.0 / 60.0;
+    const std::string resources = RESOURCES_DIRECTORY;
+    glm::mat4 view_matrix = glm::scale(glm::mat4(1.0f), glm::vec3(0.1f, 0.1f, 0.1f));
+
+    CameraBuffer camera;
+    camera.Init();
+    camera.Update(view_matrix);
+
+    ShaderCache shaders;
+    shaders.Init(resources, &camera, nullptr);
+    Shader* particle_shader = shaders.Get("/particle_vertex_shader.glsl", "/particle_fragment_shader.glsl", { "EXPLOSION_PARTICLE" });
+    Shader* instanced_shader = shaders.Get("/particle_instanced_vertex_shader.glsl", "/particle_fragment_shader.glsl", { "EXPLOSION_PARTICLE" });
+    Shader* composite_shader = shaders.Get("/particle_composite_vertex_shader.glsl", "/particle_composite_fragment_shader.glsl");
+
+    // a white texel, so no fragment is discarded
+    GLuint texture;
+    GLubyte white[] = { 255, 255, 255, 255 };
+    glGenTextures(1, &texture);
+    GLState::BindTexture(texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    // large explosions piled in the middle of the screen, like a squad dying together
+    game::Particles geometry;
+    geometry.CreateGeometry(1.0f, 0.0f, 0.0f, 5);
+    ParticleSystem explosion(glm::vec3(0.0f, 0.0f, 0.0f), &geometry, particle_shader, texture, nullptr, EXPLOSION_PARTICLE, 5.0f, 0.7f, 0.0f);
+    ExplosionPool explosions;
+    explosions.Init(&explosion, instanced_shader);
+    std::srand(2501);
+    for (int i = 0; i < explosion_count; i++) {
+        explosions.spawn(Helper::generate2dPosition(-3.0f, 3.0f, -3.0f, 3.0f), 3.0f, 0.0);
+    }
+
+    double time_full = 0.0;
+    double time_reduced = 0.0;
+    for (int pass = 0; pass < 2; pass++) {
+        ParticleTarget target;
+        target.Init(composite_shader, divisor);
+        glFinish();
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++) {
+            glClear(GL_COLOR_BUFFER_BIT);
+            if (pass == 1) {
+                target.Bind();
+            }
+            explosions.Render(frame * delta_time);
+            if (pass == 1) {
+                target.Unbind();
+                target.Composite();
+            }
+            glFinish();
+        }
+        (pass == 0 ? time_full : time_reduced) = ElapsedMilliseconds(start);
+    }
+
+    std::cout << "Particle fill, " << explosion_count << " explosions x " << frames << " frames" << std::endl;
+    std::cout << "  full resolution " << time_full / frames << " ms/frame, 1/" << divisor << " resolution " << time_reduced / frames
+              << " ms/frame (" << time_full / time_reduced << "x)" << std::endl;
+
+    GLState::DeleteTextures(1, &texture);
+}
+
+
+void Benchmark::StateCache(int object_count, int frames)
+{
+    const double delta_time = 1.0 / 60.0;
+    const std::string resources = RESOURCES_DIRECTORY;
+    glm::mat4 view_matrix = glm::scale(glm::mat4(1.0f), glm::vec3(0.1f, 0.1f, 0.1f));
+
+    CameraBuffer camera;
+    camera.Init();
+    camera.Update(view_matrix);
+
+    ShaderCache shaders;
+    shaders.Init(resources, &camera, nullptr);
+    Shader* sprite_shader = shaders.Get("/sprite_vertex_shader.glsl", "/sprite_fragment_shader.glsl");
+    Shader* particle_shader = shaders.Get("/particle_vertex_shader.glsl", "/particle_fragment_shader.glsl", { "BULLET_PARTICLE" });
+
+    // a white texel, so no fragment is discarded
+    GLuint texture;
+    GLubyte white[] = { 255, 255, 255, 255 };
+    glGenTextures(1, &texture);
+    GLState::BindTexture(texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    // sprites in game order, each with a particle system like a bullet and its trail
+    // all off screen, so the time is what the calls cost rather than filling pixels
+    Sprite sprite;
+    sprite.CreateGeometry();
+    game::Particles geometry;
+    geometry.CreateGeometry(1.0f, 0.0f, 0.0f, 5);
+    std::vector<GameObject*> objects;
+    for (int i = 0; i < object_count; i++) {
+        GameObject* object = new GameObject(Helper::generate2dPosition(100.0f, 120.0f, 100.0f, 120.0f), &sprite, sprite_shader, texture);
+        object->AddChildObject(new ParticleSystem(glm::vec3(0.0f, 0.0f, 0.0f), &geometry, particle_shader, texture, object, BULLET_PARTICLE, 0.5f, 0.7f, 0.0f));
+        objects.push_back(object);
+    }
+
+    // uncached first, so the last frame GLStats holds is a cached one
+    double times[2];
+    int issued[2];
+    int skipped[2];
+    for (int pass = 1; pass >= 0; pass--) {
+        glFinish();
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++) {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            for (int i = 0; i < objects.size(); i++) {
+                if (pass == 1) {
+                    // every call reaches the driver, as before the cache
+                    GLState::Invalidate();
+                }
+                objects[i]->Render(frame * delta_time);
+            }
+            GLState::EndFrame();
+            GLStats::EndFrame();
+            glFinish();
+        }
+        times[pass] = ElapsedMilliseconds(start);
+        issued[pass] = GLState::getIssued();
+        skipped[pass] = GLState::getSkipped();
+    }
+
+    std::cout << "GL state cache, " << object_count << " sprites with particles x " << frames << " frames" << std::endl;
+    std::cout << "  cached " << times[0] / frames << " ms/frame (" << issued[0] << " calls, " << skipped[0] << " skipped), uncached "
+              << times[1] / frames << " ms/frame (" << issued[1] << " calls)" << std::endl;
+    GLStats::Dump(std::cout);
+
+    for (int i = 0; i < objects.size(); i++) {
+        delete objects[i];
+    }
+    GLState::DeleteTextures(1, &texture);
+}
+
+void Benchmark::TransformUpload(int object_count, int frames)
+{
+    const std::string resources = RESOURCES_DIRECTORY;
+    glm::mat4 view_matrix = glm::scale(glm::mat4(1.0f), glm::vec3(0.1f, 0.1f, 0.1f));
+
+    CameraBuffer camera;
+    camera.Init();
+    camera.Update(view_matrix);
+    TransformStream transforms;
+    transforms.Init();
+
+    ShaderCache shaders;
+    shaders.Init(resources, &camera, &transforms);
+    Shader* sprite_shader = shaders.Get("/sprite_vertex_shader.glsl", "/sprite_fragment_shader.glsl");
+
+    GLuint texture;
+    GLubyte white[] = { 255, 255, 255, 255 };
+    glGenTextures(1, &texture);
+    GLState::BindTexture(texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    // all off screen, so the time is what the calls cost rather than filling pixels
+    Sprite sprite;
+    sprite.CreateGeometry();
+    std::vector<Transform2D> objects(object_count);
+    std::srand(2501);
+    for (int i = 0; i < object_count; i++) {
+        objects[i] = Transform2D::Make(Helper::generate2dPosition(100.0f, 120.0f, 100.0f, 120.0f), Helper::generateFloat(0.0f, 6.0f), glm::vec2(1.0f));
+    }
+
+    sprite_shader->Enable();
+    sprite.SetGeometry(sprite_shader->GetShaderProgram());
+    GLState::BindTexture(texture);
+
+    const char* names[3] = { "constant per draw", "streamed per draw", "one instanced draw" };
+    double times[3];
+    for (int path = 0; path < 3; path++) {
+        glFinish();
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++) {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            transforms.BeginFrame();
+            if (path == 0) {
+                for (int i = 0; i < object_count; i++) {
+                    sprite_shader->SetTransform(objects[i]);
+                    GLStats::DrawElements(GL_TRIANGLES, sprite.GetSize(), GL_UNSIGNED_INT, 0);
+                }
+            } else if (path == 1) {
+                for (int i = 0; i < object_count; i++) {
+                    sprite_shader->SetInstanceTransforms(&objects[i], 1);
+                    GLStats::DrawElementsInstanced(GL_TRIANGLES, sprite.GetSize(), GL_UNSIGNED_INT, 0, 1);
+                    sprite_shader->ResetTransform();
+                }
+            } else {
+                sprite_shader->SetInstanceTransforms(objects.data(), object_count);
+                GLStats::DrawElementsInstanced(GL_TRIANGLES, sprite.GetSize(), GL_UNSIGNED_INT, 0, object_count);
+                sprite_shader->ResetTransform();
+            }
+            transforms.EndFrame();
+            glFinish();
+        }
+        times[path] = ElapsedMilliseconds(start);
+    }
+
+    std::cout << "Transform upload, " << object_count << " sprites x " << frames << " frames" << std::endl;
+    for (int path = 0; path < 3; path++) {
+        std::cout << "  " << names[path] << " " << times[path] / frames << " ms/frame" << std::endl;
+    }
+
+    GLState::DeleteTextures(1, &texture);
+}
+
+} // namespace game
@@ -0,0 +1,54 @@
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <chrono>
+
+namespace game {
+
+    // Micro-benchmarks comparing the batched systems against the per-object code paths
+    // Enabled with the BENCHMARK flag in config.h, they run instead of the game and print their results
+    class Benchmark {
+
+    public:
+        // Run every benchmark that does not need an OpenGL context
+        static void RunAll(void);
+
+        // Run the benchmarks that draw, in a hidden window
+        static void RunOpenGL(void);
+
+        // Enemy turn, move and intercept-aim math: EnemyGameObject one by one vs EnemySteering kernels
+        static void EnemySteering(int enemy_count, int frames);
+
+        // Bullet movement, expiry and hits: BulletObject vector vs ProjectileSystem
+        static void Projectiles(int bullet_count, int enemy_count, int frames);
+
+        // Particle emission, drag, gravity and expiry: particle structs one by one vs ParticleSimulator, plus its vertex streaming
+        static void Particles(int particle_count, int frames);
+
+        // Building per-object transforms inside a parent and unprojecting the cursor: glm::mat4 chains and inverse vs Transform2D
+        static void Transforms(int object_count, int frames);
+
+        // Updating and drawing particles: shader-only ParticleSystem vs ParticleSimulator streaming vs FeedbackParticleSystem
+        // All three draw the same particles, particle_count rounded down to whole explosion systems, with quads of the same size
+        // Needs a current OpenGL context, each frame waits for the GPU to finish
+        static void ParticleRendering(int particle_count, int frames);
+
+        // Drawing overlapping explosions straight to the screen vs into a ParticleTarget at 1 / divisor resolution
+        static void ParticleFill(int explosion_count, int divisor, int frames);
+
+        // Drawing sprites and particle systems through GLState vs with its shadow forgotten before every object,
+        // then the GLStats table of a cached frame
+        static void StateCache(int object_count, int frames);
+
+        // Drawing sprites with their transform set as a constant attribute per draw, streamed one per draw,
+        // and streamed all at once for a single instanced draw
+        static void TransformUpload(int object_count, int frames);
+
+    private:
+        static double ElapsedMilliseconds(std::chrono::steady_clock::time_point start);
+
+    }; // class Benchmark
+
+} // namespace game
+
+#endif // BENCHMARK_H_
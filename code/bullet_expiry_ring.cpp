@@ -0,0 +1,72 @@
+#include "bullet_expiry_ring.h"
+#include "bullet_object.h"
+
+namespace game {
+
+    long long BulletExpiryRing::Ring::push(const Entry& entry) {
+        if (count == entries.size()) {
+            // grow, unrolling the ring so it starts at 0 again
+            std::vector<Entry> grown(entries.empty() ? 16 : entries.size() * 2);
+            for (int i = 0; i < count; i++) {
+                grown[i] = entries[(head + i) & (entries.size() - 1)];
+            }
+            entries.swap(grown);
+            head = 0;
+        }
+        entries[(head + count) & (entries.size() - 1)] = entry;
+        count++;
+        return front_sequence + count - 1;
+    }
+
+
+    void BulletExpiryRing::Ring::pop() {
+        head = (head + 1) & (entries.size() - 1);
+        count--;
+        front_sequence++;
+    }
+
+
+    BulletExpiryRing::BulletExpiryRing() {}
+
+
+    void BulletExpiryRing::add(BulletObject* bullet) {
+        bullet->SetSlot(static_cast<int>(bullets_->size()));
+        bullets_->push_back(bullet);
+
+        Ring& ring = rings_[static_cast<int>(bullet->GetBulletType())];
+        bullet->SetExpirySequence(ring.push({ time_ + bullet->GetExpirationTime(), bullet }));
+    }
+
+
+    void BulletExpiryRing::remove(BulletObject* bullet) {
+        Ring& ring = rings_[static_cast<int>(bullet->GetBulletType())];
+        ring.at(bullet->GetExpirySequence()).bullet = nullptr;
+        erase(bullet);
+    }
+
+
+    void BulletExpiryRing::Update(double delta_time) {
+        time_ += delta_time;
+
+        for (int i = 0; i < BULLET_TYPE_COUNT; i++) {
+            Ring& ring = rings_[i];
+            while (ring.count > 0 && ring.front().expiry_time <= time_) {
+                if (ring.front().bullet != nullptr) {
+                    erase(ring.front().bullet);
+                }
+                ring.pop();
+            }
+        }
+    }
+
+
+    void BulletExpiryRing::erase(BulletObject* bullet) {
+        int slot = bullet->GetSlot();
+        BulletObject* last = static_cast<BulletObject*>(bullets_->back());
+        (*bullets_)[slot] = last;
+        last->SetSlot(slot);
+        bullets_->pop_back();
+        delete bullet;
+    }
+
+} // namespace game
@@ -0,0 +1,67 @@
+#ifndef BULLET_EXPIRY_RING_H_
+#define BULLET_EXPIRY_RING_H_
+
+#include <vector>
+
+#include "config.h"
+
+namespace game {
+
+    class BulletObject;
+    class GameObject;
+
+    /*
+        BulletExpiryRing owns the lifetime of the bullets in the bullet vector
+        Every bullet of a type lives as long and bullets are fired in order, so each type's bullets expire first in, first out
+        Bullets are queued per type with their expiry time, and each frame only the expired front of each queue is removed
+        Bullets are swap-removed from the vector through the slot they keep, so removing one does not move the others
+    */
+    class BulletExpiryRing {
+
+    public:
+        BulletExpiryRing();
+
+        void setBullets(std::vector<GameObject*>* bullets) { bullets_ = bullets; }
+
+        // pushes a new bullet onto the bullet vector and starts its lifetime
+        void add(BulletObject* bullet);
+
+        // removes and deletes a bullet before it expires
+        void remove(BulletObject* bullet);
+
+        // advances the clock and removes every bullet whose lifetime ran out
+        void Update(double delta_time);
+
+        inline double getTime() const { return time_; }
+
+    private:
+        struct Entry {
+            double expiry_time;
+            BulletObject* bullet;   // nullptr once removed early
+        };
+
+        // circular FIFO of one bullet type, entries are addressed by a sequence number that only grows
+        struct Ring {
+            std::vector<Entry> entries;     // capacity is a power of two
+            int head = 0;
+            int count = 0;
+            long long front_sequence = 0;   // sequence number of entries[head]
+
+            long long push(const Entry& entry);
+            void pop();
+            inline Entry& front() { return entries[head]; }
+            inline Entry& at(long long sequence) { return entries[(head + static_cast<int>(sequence - front_sequence)) & (entries.size() - 1)]; }
+        };
+
+        // swaps the last bullet into the bullet's slot and deletes it
+        void erase(BulletObject* bullet);
+
+        Ring rings_[BULLET_TYPE_COUNT];
+        std::vector<GameObject*>* bullets_ = nullptr;
+        double time_ = 0.0;
+
+    }; // class BulletExpiryRing
+
+} // namespace game
+
+#endif // BULLET_EXPIRY_RING_H_
@@ -1,4 +1,6 @@
 #include "bullet_object.h"
+#include "bullet_expiry_ring.h"
+#include "projectile_system.h"
 
 namespace game
 {
@@ -13,8 +15,6 @@ namespace game
 
         // set the hitbox radius (in this case, it is the length of the bullet)
         this->hitbox_radius = hitbox_radius;
-
-        trail_ = nullptr;
     }
 
     // deep copy constructor
@@ -25,27 +25,19 @@ namespace game
         direction_ = other.direction_;
         speed_ = other.speed_;
         type_ = other.type_;
-        is_alive_ = other.is_alive_;
         shooter_ = other.shooter_;
         shooter_type_ = other.shooter_type_;
         expiration_time_ = other.expiration_time_;
-        expiration_timer_ = other.expiration_timer_;
-        if (other.trail_ != nullptr) {
-            trail_ = new ParticleSystem(*other.trail_);
-            trail_->setParent(this);
-            trail_->SetScale(other.trail_->GetScale());
-        } else {
-            trail_ = nullptr;
-        }
-        enemy_objects_ = other.enemy_objects_;
+        expiry_ring_ = other.expiry_ring_;
+        trail_ = other.trail_;
+        trail_scale_ = other.trail_scale_;
+        trail_start_time_ = other.trail_start_time_;
+        enemy_tree_ = other.enemy_tree_;
         target_position_ = glm::vec3 (0.0f, 0.0f, 0.0f);
         target_found_ = false;
     }
 
-    BulletObject::~BulletObject()
-    {
-        delete trail_;
-    }
+    BulletObject::~BulletObject() {}
 
     void BulletObject::Shoot(const glm::vec3 &position, const glm::vec3 &direction, GameObject *shooter)
     {
@@ -54,28 +46,40 @@ namespace game
         shooter_ = shooter;
         shooter_type_ = shooter->getObjectType();
 
-        // start the expiration timer
-        expiration_timer_.setTime(expiration_time_);
-        is_alive_ = true;
+        if (trail_ != nullptr) {
+            trail_start_time_ = trail_->getTime();
+        }
     }
 
-    void BulletObject::Update(double delta_time)
+    void BulletObject::Fire(const glm::vec3 &position, const glm::vec3 &direction, float scale, GameObject *shooter, std::vector<GameObject*> *bullets)
     {
-        // update the expiration timer
-        expiration_timer_.Update(delta_time);
+        if (projectiles_ != nullptr) {
+            projectiles_->fire(this, position, direction, scale, shooter->getObjectType());
+            return;
+        }
+
+        // deep copy the bullet object
+        auto* new_bullet = new BulletObject(*this);
+        new_bullet->Shoot(position, direction, shooter);
+        new_bullet->SetScale(scale);
+        new_bullet->SetRotation(glm::atan(direction.y, direction.x) - glm::pi<float>() / 2.0f);
+        if (expiry_ring_ != nullptr) {
+            expiry_ring_->add(new_bullet);
+        } else {
+            bullets->push_back(new_bullet);
+        }
+    }
 
+    void BulletObject::Update(double delta_time)
+    {
         // Update direction if the bullet is homing
-        if (enemy_objects_ != nullptr) {
+        if (enemy_tree_ != nullptr) {
             // find the closest enemy
             if (!target_found_) {
-                float closest_distance = 1000000.0f;
-                for (auto& enemy : *enemy_objects_) {
-                    float distance = glm::length(enemy->GetPosition() - (position_  + GetBearing() * 0.5f));
-                    if (distance < closest_distance) {
-                        closest_distance = distance;
-                        target_position_ = enemy->GetPosition();
-                        target_found_ = true;
-                    }
+                GameObject* enemy = enemy_tree_->nearest(position_ + GetBearing() * 0.5f, MAX_HOMING_DISTANCE);
+                if (enemy != nullptr) {
+                    target_position_ = enemy->GetPosition();
+                    target_found_ = true;
                 }
             }
             // if an enemy is found, slowly change direction to face the enemy
@@ -95,30 +99,24 @@ namespace game
         // Move the bullet in the direction it was shot
         position_ += direction_ * speed_ * (float)delta_time;
         GameObject::Update(delta_time);
+    }
 
-        // update trail if it exists
-        if (trail_ != nullptr)
-        {
-            trail_->Update(delta_time);
-        }
+    void BulletObject::Render(double current_time)
+    {
 
-        // if the bullet has expired, remove it from the game
-        if (expiration_timer_.timesUp())
-        {
-            is_alive_ = false;  // main game loop will remove the bullet from the game
-        }
+        AddTrail();
+
+        GameObject::Render(current_time);
     }
 
-    void BulletObject::Render(glm::mat4 view_matrix, double current_time)
-    {
 
-        // render trail if it exists
+    void BulletObject::AddTrail(void)
+    {
+        // the trail renderer draws them all at once
         if (trail_ != nullptr)
         {
-            trail_->Render(view_matrix, current_time);
+            trail_->add(type_, position_, angle_, trail_scale_, trail_start_time_);
         }
-
-        GameObject::Render(view_matrix, current_time);
     }
 
     // check if the bullet has already hit the object
@@ -5,11 +5,15 @@
 
 #include "config.h"
 #include "game_object.h"
+#include "kd_tree.h"
 #include "timer.h"
-#include "particle_system.h"
+#include "trail_renderer.h"
 
 namespace game
 {
+    class BulletExpiryRing;
+    class ProjectileSystem;
+
     class BulletObject : public GameObject
     {
     public:
@@ -23,26 +27,39 @@ namespace game
         inline float GetSpeed() const { return speed_; };
         ObjectType GetShooterType() const { return shooter_type_; }
         float GetDamage() const { return damage_; }
-        bool IsAlive() const { return is_alive_; }
         BulletType GetBulletType() const { return type_; }
+        float GetExpirationTime() const { return expiration_time_; }
+        int GetSlot() const { return slot_; }
+        long long GetExpirySequence() const { return expiry_sequence_; }
 
         // setters
         void SetScale(float scale) {
             GameObject::SetScale(scale);
             hitbox_radius = scale / 10.f;
         }
-        void SetTrail(ParticleSystem* trail, float scale) {
-            trail_ = new ParticleSystem(*trail);
-            trail_->setParent(this);
-            trail_->SetScale(scale);
+        void SetTrail(TrailRenderer* trail, float scale) {
+            trail_ = trail;
+            trail_scale_ = scale;
         }
-        void SetEnemyObjects(vector<GameObject*>* enemy_objects) { enemy_objects_ = enemy_objects; }
+        void SetEnemyTree(const KdTree* enemy_tree) { enemy_tree_ = enemy_tree; }
+        // shots of this template are added through the expiry ring, which removes them once they expire
+        void SetExpiryRing(BulletExpiryRing* expiry_ring) { expiry_ring_ = expiry_ring; }
+        void SetSlot(int slot) { slot_ = slot; }
+        void SetExpirySequence(long long sequence) { expiry_sequence_ = sequence; }
+        // shots of this template go to the projectile system instead of the bullet vector
+        void SetProjectiles(ProjectileSystem* projectiles) { projectiles_ = projectiles; }
+        // when the trail animation started, normally the time of the shot
+        void SetTrailStartTime(double start_time) { trail_start_time_ = start_time; }
 
         // utility
         void Shoot(const glm::vec3& position, const glm::vec3& direction, GameObject* shooter);
+        // shoots a copy of this template into bullets, or into the projectile system when one is set
+        void Fire(const glm::vec3& position, const glm::vec3& direction, float scale, GameObject* shooter, std::vector<GameObject*>* bullets);
         void Update(double delta_time) override;
         bool Pierce(GameObject* object);
-        void Render(glm::mat4 view_matrix, double current_time) override;
+        void Render(double current_time) override;
+        // queues the trail with the shared trail renderer, if the bullet has one
+        void AddTrail(void);
 
         // helpers
         bool isBullet() override { return true; };
@@ -58,17 +75,23 @@ namespace game
 
         // expiration variables
         float expiration_time_;
-        Timer expiration_timer_;
-        bool is_alive_ = true;
+        BulletExpiryRing* expiry_ring_ = nullptr;
+        int slot_ = -1;                     // index in the bullet vector
+        long long expiry_sequence_ = -1;    // entry in the expiry ring
 
         // homing variables
         vector <GameObject*> hit_objects_;
-        vector <GameObject*>* enemy_objects_ = nullptr;
+        const KdTree* enemy_tree_ = nullptr;
         glm::vec3 target_position_;
         bool target_found_ = false;
 
-        // particle system for the bullet trail
-        ParticleSystem* trail_ = nullptr;
+        // set on templates when bullets are simulated by the projectile system
+        ProjectileSystem* projectiles_ = nullptr;
+
+        // bullet trail, drawn by the shared trail renderer
+        TrailRenderer* trail_ = nullptr;
+        float trail_scale_ = 1.0f;
+        double trail_start_time_ = 0.0;
     };
 }
 
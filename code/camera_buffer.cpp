@@ -0,0 +1,42 @@
+#include "camera_buffer.h"
+#include "gl_state.h"
+#include "gl_stats.h"
+
+namespace game {
+
+    CameraBuffer::CameraBuffer(void) {}
+
+
+    CameraBuffer::~CameraBuffer()
+    {
+        if (ubo_ != 0) {
+            GLState::DeleteBuffers(1, &ubo_);
+        }
+    }
+
+
+    void CameraBuffer::Init(void)
+    {
+        glGenBuffers(1, &ubo_);
+        GLState::BindBuffer(GL_UNIFORM_BUFFER, ubo_);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), NULL, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UNIFORM_BINDING, ubo_);
+    }
+
+
+    void CameraBuffer::Attach(Shader* shader)
+    {
+        shader->BindUniformBlock("Camera", CAMERA_UNIFORM_BINDING);
+    }
+
+
+    void CameraBuffer::Update(const glm::mat4& view_matrix)
+    {
+        // a mat4 has the same layout in C++ and in a std140 block
+        GLStats::CountUniform();
+        GLState::BindBuffer(GL_UNIFORM_BUFFER, ubo_);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), &view_matrix);
+        glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UNIFORM_BINDING, ubo_);
+    }
+
+} // namespace game
@@ -0,0 +1,40 @@
+#ifndef CAMERA_BUFFER_H_
+#define CAMERA_BUFFER_H_
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "config.h"
+#include "shader.h"
+
+namespace game {
+
+    /*
+        CameraBuffer holds the per-frame camera data in one uniform buffer, bound at CAMERA_UNIFORM_BINDING
+        Every shader declaring the Camera block reads it from there, so the view matrix is uploaded once per frame
+        instead of once per object
+    */
+    class CameraBuffer {
+
+    public:
+        CameraBuffer(void);
+        ~CameraBuffer();
+
+        // Call once there is an OpenGL context
+        void Init(void);
+
+        // Points the shader's Camera block at this buffer
+        void Attach(Shader* shader);
+
+        // Uploads this frame's camera
+        void Update(const glm::mat4& view_matrix);
+
+    private:
+        GLuint ubo_ = 0;
+
+    }; // class CameraBuffer
+
+} // namespace game
+
+#endif // CAMERA_BUFFER_H_
@@ -6,12 +6,14 @@ namespace game
         : GameObject(position, geom, shader, texture), type_(type)
     {
         hitbox_radius = 0.5f;
+        needs_update = false;   // static until given a movement
     }
 
     // Set the movement of the collectible object to be circular
     void CollectibleGameObject::SetMovement(float radius, float time, const glm::vec2& center)
     {
         circular_movement = true;
+        needs_update = true;
         radius_ = radius;
         time_ = time;
         center_ = center;
@@ -8,13 +8,14 @@ namespace game {
 
 
 	void CollisionHandler::setUp(vector <GameObject*>* player_vector, vector <GameObject*>* enemy_vector,
-                                 vector <GameObject*>* bullet_vector, vector <GameObject*>* collectible_vector,
-                                 vector <TurretObject*>& turret_templates,
+                                 vector <GameObject*>* bullet_vector, BulletExpiryRing* bullet_expiry_ring,
+                                 vector <GameObject*>* collectible_vector, vector <TurretObject*>& turret_templates,
 								 CollectibleGameObject** win_1, CollectibleGameObject** win_2,
 								 CollectibleGameObject** win_3, CollectibleGameObject** win_4) {
 		player_objects_ = player_vector;
 		enemy_objects_ = enemy_vector;
 		bullet_objects_ = bullet_vector;
+		bullet_expiry_ring_ = bullet_expiry_ring;
         collectible_objects_ = collectible_vector;
         turret_templates_ = turret_templates;
 		win_collectible_objects_.push_back(win_1);
@@ -31,27 +32,35 @@ namespace game {
         collectibleCollision(delta_time);
 	}
 
+	// Enemy type dispatch, only charge enemies can be charging
+
+	static bool isCharging(EnemyGameObject* enemy) {
+		return enemy->isChargeType() && static_cast<ChargeEnemyObject*>(enemy)->isCharging();
+	}
+
+
 	// Player Collision
 
 	void CollisionHandler::playerCollision(double delta_time) {
 		for (int i = 0; i < player_objects_->size(); i++) {
-			PlayerGameObject* current_player_object = dynamic_cast<PlayerGameObject*>((*player_objects_)[i]);
+			PlayerGameObject* current_player_object = static_cast<PlayerGameObject*>((*player_objects_)[i]);
 			// Enemy
 			for (int j = 0; j < enemy_objects_->size(); j++) {
-				EnemyGameObject* current_enemy_object = dynamic_cast<EnemyGameObject*>((*enemy_objects_)[j]);
+				EnemyGameObject* current_enemy_object = static_cast<EnemyGameObject*>((*enemy_objects_)[j]);
 
-				// hitbox collision
-				float distance_to_enemy = glm::length(current_player_object->GetPosition() - current_enemy_object->GetPosition());
+				// hitbox collision, distance from the player relative cache
+				float distance_to_enemy = current_enemy_object->getPlayerDistance();
 				float hitbox_distance = current_player_object->getHitbox() + current_enemy_object->getHitbox();
 				if (distance_to_enemy <= hitbox_distance) {
 					// collides
 					current_enemy_object->knockback(current_player_object, 1.0f);
 					current_enemy_object->takeDamage(current_player_object->getMeleeDamage(), current_player_object->GetPosition());
 					
-					if (current_enemy_object->isCharging()) {
-						current_player_object->knockback(current_enemy_object, 3.0f);
-						current_player_object->takeDamage(current_enemy_object->getChargeDamage());
-						current_enemy_object->stopCharging();
+					if (isCharging(current_enemy_object)) {
+						ChargeEnemyObject* charge_enemy_object = static_cast<ChargeEnemyObject*>(current_enemy_object);
+						current_player_object->knockback(charge_enemy_object, 3.0f);
+						current_player_object->takeDamage(charge_enemy_object->getChargeDamage());
+						charge_enemy_object->stopCharging();
 					}
 					else {
 						current_player_object->knockback(current_enemy_object, 1.0f);
@@ -61,7 +70,7 @@ namespace game {
 
 				// saw collision
 				if (current_enemy_object->isMeleeType()) {
-					SawObject* current_saw_object = dynamic_cast<MeleeEnemyObject*>(current_enemy_object)->getSaw();
+					SawObject* current_saw_object = static_cast<MeleeEnemyObject*>(current_enemy_object)->getSaw();
 					float distance_to_saw = glm::length(current_player_object->GetPosition() - current_saw_object->GetPosition());
 					hitbox_distance = current_player_object->getHitbox() + current_saw_object->getHitbox();
 					if (distance_to_saw <= hitbox_distance) {
@@ -80,22 +89,23 @@ namespace game {
 
 	void CollisionHandler::enemyCollision(double delta_time) {
 		for (int i = 0; i < enemy_objects_->size(); i++) {
-			EnemyGameObject* current_enemy_object = dynamic_cast<EnemyGameObject*>((*enemy_objects_)[i]);
+			EnemyGameObject* current_enemy_object = static_cast<EnemyGameObject*>((*enemy_objects_)[i]);
+			bool current_charging = isCharging(current_enemy_object);
 			// Enemy
 			for (int j = i; j < enemy_objects_->size(); j++) {
-				EnemyGameObject* target_enemy_object = dynamic_cast<EnemyGameObject*>((*enemy_objects_)[j]);
+				EnemyGameObject* target_enemy_object = static_cast<EnemyGameObject*>((*enemy_objects_)[j]);
 
 				// hitbox collision
 				float distance_to_enemy = glm::length(current_enemy_object->GetPosition() - target_enemy_object->GetPosition());
 				float hitbox_distance = current_enemy_object->getHitbox() + target_enemy_object->getHitbox();
 				if (distance_to_enemy <= hitbox_distance) {
-					if (current_enemy_object->isCharging()) {
-						if (!target_enemy_object->isCharging()) {
+					if (current_charging) {
+						if (!isCharging(target_enemy_object)) {
 							target_enemy_object->knockback(current_enemy_object, 1.0f);
 						}
 
 					}
-					else if (target_enemy_object->isCharging()) {
+					else if (isCharging(target_enemy_object)) {
 						current_enemy_object->knockback(target_enemy_object, 1.0f);
 					}
 					else {
@@ -131,7 +141,8 @@ namespace game {
                     else {
                         enemy_hit->takeDamage(current_bullet->GetDamage(), current_bullet->GetPosition());
                         enemy_hit->knockback(current_bullet, 1.0f);
-                        Helper::removeByIndex(bullet_objects_, i);
+                        // the last bullet is swapped into i
+                        bullet_expiry_ring_->remove(current_bullet);
                         i--;
                     }
 					continue;
@@ -144,7 +155,7 @@ namespace game {
 					PlayerGameObject* player = dynamic_cast<PlayerGameObject*>((*player_objects_)[index]);
 					player->takeDamage(current_bullet->GetDamage());
 					player->knockback(current_bullet, 0.5);
-					Helper::removeByIndex(bullet_objects_, i);
+					bullet_expiry_ring_->remove(current_bullet);
 					i--;
 					continue;
 				}
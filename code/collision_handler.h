@@ -10,10 +10,10 @@
 #include "config.h"
 #include "helper.h"
 
+#include "bullet_expiry_ring.h"
 #include "bullet_object.h"
 #include "charge_enemy_object.h"
 #include "enemy_game_object.h"
-#include "explosion.h"
 #include "game_object.h"
 #include "helper.h"
 #include "melee_enemy_object.h"
@@ -33,8 +33,8 @@ namespace game {
 		~CollisionHandler();
 
 		void setUp(vector <GameObject*>* player_vector, vector <GameObject*>* enemy_vector,
-                   vector <GameObject*>* bullet_vector, vector <GameObject*>* collectible_vector,
-                   vector <TurretObject*>& turret_templates,
+                   vector <GameObject*>* bullet_vector, BulletExpiryRing* bullet_expiry_ring,
+                   vector <GameObject*>* collectible_vector, vector <TurretObject*>& turret_templates,
 				   CollectibleGameObject** win_1, CollectibleGameObject** win_2,
 				   CollectibleGameObject** win_3, CollectibleGameObject** win_4);
 
@@ -66,6 +66,7 @@ namespace game {
 
 		// Bullet
 		vector <GameObject*>* bullet_objects_;
+		BulletExpiryRing* bullet_expiry_ring_;
 
         // Collectibles
         vector <GameObject*>* collectible_objects_;
@@ -5,6 +5,13 @@
 #define TEST false
 #define SPAWN_ENEMY true
 
+// run the micro-benchmarks in benchmark.cpp instead of the game
+#define BENCHMARK false
+
+// render a fixed scene into a framebuffer object with a headless context instead of running the game, see Game::RenderBenchmark
+// the context comes from EGL, so the build needs the USE_EGL CMake option
+#define RENDER_BENCHMARK false
+
 #include <iostream>
 
 // config files for constants
@@ -15,7 +22,6 @@ enum class ObjectType {
     Turret,
     Enemy,
     Bullet,
-    Explosion,
     UI
 };
 
@@ -44,6 +50,18 @@ enum class ObjectType {
 #define MAX_ENEMY_COUNT 500
 #define SPAWN_ATTEMPT 3     // number of attempts per enemy spawn when enemy spawned within other game objects
 #define ENEMY_DESPAWN_RANGE 100.0f
+#define ENEMY_IDLE_THINK_TIME 0.25f     // seconds between perception checks of idle enemies
+
+// shared steering grid around the player for engaged enemies
+#define FLOW_FIELD_SIZE 32                  // cells per side, covers the largest engage radius
+#define FLOW_FIELD_CELL_SIZE 2.0f
+#define FLOW_FIELD_DIRECT_RANGE 1           // cells around the player where enemies steer directly at it
+#define FLOW_FIELD_SEPARATION_WEIGHT 0.25f  // heading push per enemy of difference between neighbour cells
+
+// squads, enemies spawned near an unengaged leader follow it instead of running their own AI
+#define SQUAD_SIZE 5
+#define SQUAD_JOIN_RANGE 10.0f              // max distance from a new enemy to the leader it joins
+#define SQUAD_FORMATION_ARRIVE_DISTANCE 0.5f
 
 // enemy types
 enum class EnemyType {
@@ -136,7 +154,10 @@ enum class EnemyState {
 
 #define CHARGE_ENEMY_MAX_ENGAGE_RANGE 15.0f
 
-#define CHARGE_ENEMY_RATE_OF_FIRE 0.2f;
+#define CHARGE_ENEMY_RATE_OF_FIRE 0.2f
+
+// largest of the enemy sizes, bounds the radius of hitbox searches
+#define MAX_ENEMY_SIZE CHARGE_ENEMY_SIZE
 
 // player
 
@@ -161,6 +182,14 @@ enum class BulletType
     BIGBULLET,
     HOMING
 };
+#define BULLET_TYPE_COUNT 5
+
+// most trails drawn per bullet type each frame, the rest of the bullets draw without one
+#define BULLET_TRAIL_BUDGET 1024
+#define MACHINE_BULLET_TRAIL_BUDGET 256
+
+// simulate bullets as packed data in ProjectileSystem instead of one BulletObject each
+#define USE_PROJECTILE_SYSTEM false
 
 
 // turret
@@ -208,9 +237,88 @@ enum class WeaponShootKey
 #define BULLET_PARTICLE 10
 #define EXPLOSION_PARTICLE 11
 
+// most explosions shown at once, the oldest is replaced past it
+#define MAX_EXPLOSIONS 256
+
+// most particles simulated on the cpu at once, emitters stop spawning past it
+#define MAX_SIMULATED_PARTICLES 100000
+#define EXPLOSION_SPARK_COUNT 40
+
+// simulate the sparks on the gpu with transform feedback instead of on the cpu, needs OpenGL 3.3 (instanced draws with attribute divisors)
+// and falls back to the cpu without it
+#define USE_GPU_PARTICLES false
+
+// draw every particle into an offscreen target at 1 / PARTICLE_RESOLUTION_DIVISOR of the screen resolution, added over the scene once per frame
+#define USE_REDUCED_RESOLUTION_PARTICLES false
+#define PARTICLE_RESOLUTION_DIVISOR 2
+
+
+// rendering
+
+// world units are scaled by this into the view, whose shorter side spans two units
+#define CAMERA_ZOOM 0.10f
+
+// generate mip chains for textures and sample the nearest level; levels wider than a texture is ever drawn at CAMERA_ZOOM
+// in the current window are dropped when it is loaded, and loaded again if the window grows, see TextureLoader
+#define USE_TEXTURE_MIPMAPS true
+
+// internal format a texture is stored in, picked per asset in Game::SetAllTextures
+// the compressed formats are S3TC, where the driver does not support it they fall back to the nearest uncompressed format
+enum class TextureFormat
+{
+    RGBA8,
+    RGBA4,              // few colours with soft edges
+    RGB5_A1,            // few colours with hard edged transparency
+    LUMINANCE,          // opaque grey, one channel read back as grey
+    COMPRESSED_RGB,     // opaque, DXT1
+    COMPRESSED_RGBA     // many colours with soft transparency, DXT5
+};
+
+// store textures in the format of their asset instead of RGBA8
+#define USE_COMPACT_TEXTURES true
+
+// print the memory each texture takes and what it saves over RGBA8 once they are all loaded
+#define REPORT_TEXTURE_MEMORY false
+
+// uniform buffer binding point of the per-frame camera block every shader shares
+#define CAMERA_UNIFORM_BINDING 0
+
+// per-object transforms each frame can stream, and how many frames of them the ring keeps in flight
+#define TRANSFORM_STREAM_CAPACITY 16384
+#define TRANSFORM_STREAM_FRAMES 3
+
+// count the GL calls of each frame by source for the GLStats table, false compiles it out and keeps only the total draws
+#define USE_GL_STATS false
+
+// print the GL state calls issued and skipped, and the GLStats table of GL calls by source, for a frame once a second
+#define REPORT_GL_STATE false
+
+// groups of draws, in the order they run each frame: depth tested sprites front to back,
+// additive particles over all of them, bullets included, then ui and text
+enum class RenderPass
+{
+    SCENE,
+    PARTICLES,
+    OVERLAY
+};
+
+// batched systems drawn through the render queue instead of a game object
+enum class RenderSystem
+{
+    NONE,
+    PROJECTILES,
+    EXPLOSIONS,
+    SPARKS,
+    TRAILS
+};
 
-// UI
-#define HEALTH_BAR 1000
-#define ARROW 1001
+// render benchmark scene: frames drawn, the seed of everything Setup places at random, objects added around the player,
+// and how far the scene's particles are advanced before the first frame
+#define RENDER_BENCHMARK_FRAMES 300
+#define RENDER_BENCHMARK_SEED 2501
+#define RENDER_BENCHMARK_ENEMIES 200
+#define RENDER_BENCHMARK_BULLETS 200
+#define RENDER_BENCHMARK_EXPLOSIONS 24
+#define RENDER_BENCHMARK_SCENE_TIME 0.25
 
 #endif
\ No newline at end of file
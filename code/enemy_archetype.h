@@ -0,0 +1,52 @@
+#ifndef ENEMY_ARCHETYPE_H_
+#define ENEMY_ARCHETYPE_H_
+
+#include "enemy_game_object.h"
+#include "enemy_traits.h"
+
+namespace game {
+
+	/*
+		EnemyArchetype is the CRTP base of the concrete enemy types. It fills the shared properties
+		from EnemyTraits<Type> and lets Derived run the state machine with its own engage and charge
+		actions bound at compile time (see EnemyGameObject::updateEnemy)
+	*/
+	template <class Derived, EnemyType Type>
+	class EnemyArchetype : public EnemyGameObject {
+
+	public:
+		typedef EnemyTraits<Type> Traits;
+
+		EnemyArchetype(const glm::vec3& position, Geometry* geom, Shader* shader, GLuint texture, PlayerGameObject* player)
+			: EnemyGameObject(position, geom, shader, texture, player) {
+			type = Type;
+
+			size = Traits::size;
+			SetScale(size);
+			setHitboxRadius(this->GetScale() / 2);
+			setHealth(Traits::health);
+
+			melee_damage = Traits::melee_damage;
+
+			weight = Traits::weight;
+
+			idle_detection_radius = Traits::idle_detection_radius;
+			engage_detection_radius = Traits::engage_detection_radius;
+
+			idle_vision_cone = 0.0f;	// in radians. from 0 rad
+			engage_vision_cone = 0.0f;	// in radians, from 0 rad
+
+			speed = Traits::speed;
+			turn_speed = Traits::turn_speed;	// in radians
+
+			wander_chance = Traits::wander_chance;
+			wander_range = Traits::wander_range;
+		}
+
+		EnemyGameObject* clone() const override { return new Derived(static_cast<const Derived&>(*this)); };
+
+	}; // class EnemyArchetype
+
+} // namespace game
+
+#endif // ENEMY_ARCHETYPE_H_
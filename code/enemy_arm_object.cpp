@@ -11,6 +11,15 @@ namespace game {
 		child_attach_offset_x = GetScale() / 2;
 	}
 
+	EnemyArmObject::EnemyArmObject(const EnemyArmObject& other)
+		: GameObject(other), swing(other.swing), max_swing_angle(other.max_swing_angle), swinging_cw(other.swinging_cw),
+		  swing_angle(other.swing_angle), model_offset_x(other.model_offset_x), child_attach_offset_x(other.child_attach_offset_x),
+		  turn_speed(other.turn_speed), target_position(other.target_position), parent_angle(other.parent_angle) {
+		child_objects_.clear();
+		child_arm = nullptr;
+		saw_object = nullptr;
+	}
+
 	void EnemyArmObject::Update(double delta_time) {
 
 		if (swing) {
@@ -34,17 +43,18 @@ namespace game {
 			turnTowardsTarget(delta_time);
 		}
 		
-		// Update all child objects
-		for (auto child : child_objects_) {
-			EnemyArmObject* current = dynamic_cast<EnemyArmObject*>(child);
-			current->SetPosition(GetPosition() + GetBearing() * child_attach_offset_x + current->getModelPosition());
-			current->setTargetPosition(target_position);
-			current->setModelRotation(GetRotation());
-			child->Update(delta_time);
+		// the child arm and saw attach at the end of this arm
+		glm::vec3 attach_position = GetPosition() + GetBearing() * child_attach_offset_x;
+
+		if (child_arm != nullptr) {
+			child_arm->SetPosition(attach_position + child_arm->getModelPosition());
+			child_arm->setTargetPosition(target_position);
+			child_arm->setModelRotation(GetRotation());
+			child_arm->Update(delta_time);
 		}
 
 		if (saw_object != nullptr) {
-			saw_object->SetPosition(GetPosition() + GetBearing() * child_attach_offset_x);
+			saw_object->SetPosition(attach_position);
 			saw_object->Update(delta_time);
 		}
 	}
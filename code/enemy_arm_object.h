@@ -11,13 +11,16 @@ namespace game {
 	public:
 		EnemyArmObject(const glm::vec3& position, Geometry* geom, Shader* shader, GLuint texture, bool swing = false);
 
+		// copies the arm without its child arm and saw, the owner reattaches copies of those
+		EnemyArmObject(const EnemyArmObject& other);
+
 		void Update(double delta_time) override;
 
 		// getters
 		glm::vec3 getModelPosition();
 
 		// setters
-		inline void addArm(EnemyArmObject* arm) { child_objects_.push_back(arm); };
+		inline void addArm(EnemyArmObject* arm) { child_objects_.push_back(arm); child_arm = arm; };
 		inline void addSaw(SawObject* saw) { saw_object = saw; };
 		inline void setTargetPosition(glm::vec3 target_position) { this->target_position = target_position; };
 		inline void setModelRotation(float angle) { parent_angle = angle; };
@@ -40,6 +43,7 @@ namespace game {
 		glm::vec3 target_position = glm::vec3(0, 0, 0);
 		float parent_angle = 0;
 
+		EnemyArmObject* child_arm = nullptr;	// also in child_objects_, which owns it
 		SawObject* saw_object = nullptr;
 
 	}; // class MeleeEnemyObject
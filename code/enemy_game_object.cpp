@@ -13,77 +13,26 @@ namespace game {
 		setHitboxRadius(this->GetScale() / 2);
 	}
 
-	void EnemyGameObject::Update(double delta_time) {
-		glm::vec3 player_position = player_->GetPosition();
-		float player_distance = glm::length(player_->GetPosition() - GetPosition());
-
-		switch (state) {
-			
-		// Idle
-		case EnemyState::IDLE:
-			if (player_distance <= idle_detection_radius) {	// detects player
-				state = EnemyState::ENGAGE;
-				target_position = player_->GetPosition();
-				break;
-			}
-
-			if (Helper::roll(wander_chance)) {
-				glm::vec3 target_displacement = Helper::generate2dPosition(-wander_range, wander_range, -wander_range, wander_range);
-				target_position = position_ + target_displacement;
-				state = EnemyState::WANDER;
-				break;
-			}
-			break;
-
-		// Wander
-		case EnemyState::WANDER:
-			if (player_distance <= idle_detection_radius) {	// detects player
-				state = EnemyState::ENGAGE;
-				target_position = player_->GetPosition();
-				break;
-			}
-			if (glm::length(target_position - GetPosition()) <= 0.05f) {		// arrived at target
-				state = EnemyState::IDLE;
-				break;
-			}
-			moveTowardsTarget(delta_time, false);
-			
-			break;
-
-		case EnemyState::ALERT:
-			alert_timer.Update(delta_time);
-			if (alert_timer.timesUp()) {
-				state = EnemyState::IDLE;
-				break;
-			}
-			if (player_distance <= alert_detection_radius) {	// detects player
-				state = EnemyState::ENGAGE;
-				target_position = player_->GetPosition();
-				break;
-			}
-			turnTowardsTarget(delta_time);
-			break;
-
-		// Engage
-		case EnemyState::ENGAGE:
-			engageAction(delta_time);
-			if (player_distance > engage_detection_radius) {	// player leaves detect zone
-				state = EnemyState::WANDER;
-				break;
-			}
-			break;
-		
-		case EnemyState::CHARGE:
-			charge(delta_time);
-			break;
+	EnemyGameObject::~EnemyGameObject() {
+		if (steering_ != nullptr) {
+			steering_->remove(this);
 		}
+		if (squad_ != nullptr) {
+			squad_->remove(this);
+		}
+	}
 
-		GameObject::Update(delta_time);
+	void EnemyGameObject::Update(double delta_time) {
+		updateEnemy(this, delta_time);
 	}
 
 
 	void EnemyGameObject::takeDamage(float damage, glm::vec3 damage_position) {
 		GameObject::takeDamage(damage);
+		// damaged members break off from their squad
+		if (squad_ != nullptr && squad_->getLeader() != this) {
+			squad_->remove(this);
+		}
 		if (state != EnemyState::ENGAGE) {
 			target_position = damage_position;
 			state = EnemyState::ALERT;
@@ -93,8 +42,7 @@ namespace game {
 
 
 	void EnemyGameObject::engageAction(double delta_time) {
-		target_position = player_->GetPosition();
-		moveTowardsTarget(delta_time, true);
+		chasePlayer(delta_time);
 	}
 
 
@@ -104,9 +52,19 @@ namespace game {
 
 
 	void EnemyGameObject::moveTowardsTarget(double delta_time, bool ram_into_target) {
+		moveTowards(delta_time, target_position, ram_into_target);
+	}
+
+
+	void EnemyGameObject::moveTowards(double delta_time, glm::vec3 destination, bool ram_into_target) {
+		if (steering_ != nullptr) {
+			steering_->queueMove(this, destination, ram_into_target);
+			return;
+		}
+
 		// turns toward target
 		glm::vec3 self_direction = GetBearing();
-		glm::vec3 target_vector = target_position - GetPosition();
+		glm::vec3 target_vector = destination - GetPosition();
 
 		float angle_difference = Helper::angleBetweenVectors(self_direction, target_vector);
 		float angle_displacement = turn_speed * static_cast<float>(delta_time);
@@ -148,7 +106,26 @@ namespace game {
 	}
 
 
+	void EnemyGameObject::chasePlayer(double delta_time) {
+		target_position = player_->GetPosition();
+
+		glm::vec3 heading;
+		if (flow_field_ != nullptr && flow_field_->sample(GetPosition(), &heading)) {
+			// head along the field, keeping the distance so the turning radius check still applies
+			float player_distance = getPlayerDistance();
+			moveTowards(delta_time, GetPosition() + heading * player_distance, true);
+		} else {
+			moveTowardsTarget(delta_time, true);
+		}
+	}
+
+
 	void EnemyGameObject::turnTowardsTarget(double delta_time) {
+		if (steering_ != nullptr) {
+			steering_->queueTurn(this, target_position);
+			return;
+		}
+
 		glm::vec3 self_direction = GetBearing();
 		glm::vec3 target_vector = target_position - GetPosition();
 
@@ -168,6 +145,62 @@ namespace game {
 	}
 
 
+	void EnemyGameObject::aimAtPlayer(double delta_time, float projectile_speed, float time_offset) {
+		if (steering_ != nullptr) {
+			steering_->queueAim(this, projectile_speed, time_offset);
+			return;
+		}
+
+		target_position = getPlayerSpeedIntersactionPoint(GetPosition(), projectile_speed, time_offset);
+		turnTowardsTarget(delta_time);
+	}
+
+
+	bool EnemyGameObject::followSquad(double delta_time) {
+		EnemyGameObject* leader = squad_->getLeader();
+
+		// break off once the leader engages, or when close enough to engage the player alone
+		EnemyState leader_state = leader->getState();
+		if (leader_state == EnemyState::ENGAGE || leader_state == EnemyState::CHARGE || getPlayerDistance() <= idle_detection_radius) {
+			squad_->remove(this);
+			state = EnemyState::ENGAGE;
+			target_position = player_->GetPosition();
+			return false;
+		}
+
+		state = leader_state;
+		if (state == EnemyState::ALERT) {
+			// look where the leader looks
+			target_position = leader->getTargetPosition();
+			turnTowardsTarget(delta_time);
+		}
+		else {
+			// hold formation
+			target_position = leader->GetPosition() + formation_offset;
+			if (glm::length(target_position - GetPosition()) > SQUAD_FORMATION_ARRIVE_DISTANCE) {
+				moveTowardsTarget(delta_time, false);
+			}
+		}
+		return true;
+	}
+
+
+	float EnemyGameObject::getPlayerDistance() {
+		if (player_cache_ != nullptr && player_cache_index >= 0) {
+			return player_cache_->getDistance(player_cache_index);
+		}
+		return glm::length(player_->GetPosition() - GetPosition());
+	}
+
+
+	glm::vec3 EnemyGameObject::getPlayerDirection() {
+		if (player_cache_ != nullptr && player_cache_index >= 0) {
+			return player_cache_->getDirection(player_cache_index);
+		}
+		return glm::normalize(player_->GetPosition() - GetPosition());
+	}
+
+
 	bool EnemyGameObject::isFacingTarget(float max_angle_difference) {
 		glm::vec3 self_direction = GetBearing();
 		glm::vec3 target_vector = target_position - GetPosition();
@@ -178,17 +211,47 @@ namespace game {
 	}
 
 
+	void EnemyGameObject::whenFacingTarget(float max_angle_difference) {
+		// the turn is still queued, check once it is applied
+		if (steering_ != nullptr && steering_slot >= 0) {
+			facing_check_angle = max_angle_difference;
+			return;
+		}
+
+		if (isFacingTarget(max_angle_difference)) {
+			facingTarget();
+		}
+	}
+
+
+	void EnemyGameObject::steeringApplied(void) {
+		if (facing_check_angle < 0.0f) {
+			return;
+		}
+
+		float max_angle_difference = facing_check_angle;
+		facing_check_angle = -1.0f;
+		if (isFacingTarget(max_angle_difference)) {
+			facingTarget();
+		}
+	}
+
+
 	glm::vec3 EnemyGameObject::getPlayerSpeedIntersactionPoint(glm::vec3 start_position, float self_speed, float time_offset) {
 		glm::vec3 player_position = player_->GetPosition() + player_->GetVelocity() * time_offset;
 		glm::vec3 player_destination = player_position + player_->GetVelocity();
 		glm::vec3 player_velocity = player_->GetVelocity();
 
-		float a = pow(player_velocity.x, 2) + pow(player_velocity.y, 2) - pow(self_speed, 2);
-		float b = 2 * (player_velocity.x * (player_position.x - start_position.x) + player_velocity.y * (player_position.y - start_position.y));
-		float c = pow(player_position.x - start_position.x, 2) + pow(player_position.y - start_position.y, 2);
+		float dx = player_position.x - start_position.x;
+		float dy = player_position.y - start_position.y;
+
+		float a = player_velocity.x * player_velocity.x + player_velocity.y * player_velocity.y - self_speed * self_speed;
+		float b = 2 * (player_velocity.x * dx + player_velocity.y * dy);
+		float c = dx * dx + dy * dy;
 
-		float t1 = (-b + sqrt(pow(b, 2) - (4 * a * c))) / (2 * a);
-		float t2 = (-b - sqrt(pow(b, 2) - (4 * a * c))) / (2 * a);
+		float root = sqrt(b * b - (4 * a * c));
+		float t1 = (-b + root) / (2 * a);
+		float t2 = (-b - root) / (2 * a);
 
 		float t = max(t1, t2);
 
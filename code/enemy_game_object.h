@@ -4,6 +4,10 @@
 #include "config.h"
 
 #include "player_game_object.h"
+#include "enemy_steering.h"
+#include "flow_field.h"
+#include "enemy_squad.h"
+#include "player_relative_cache.h"
 
 namespace game {
 
@@ -11,6 +15,7 @@ namespace game {
 
 	public:
 		EnemyGameObject(const glm::vec3& position, Geometry* geom, Shader* shader, GLuint texture, PlayerGameObject* player);
+		~EnemyGameObject() override;
 
 		void Update(double delta_time) override;
 
@@ -19,35 +24,74 @@ namespace game {
 		inline EnemyState getState() { return state; };
 		inline float getIdleDetectionRadius() { return idle_detection_radius; };
 		inline float getEngageDetectionRadius() { return engage_detection_radius; };
-		inline virtual float getChargeDamage() { return 0.0f; };
+		inline float getSpeed() { return speed; };
+		inline float getTurnSpeed() { return turn_speed; };
+		inline int getSteeringSlot() { return steering_slot; };
+		inline glm::vec3 getTargetPosition() { return target_position; };
+		// read from this frame's player relative cache when there is one
+		float getPlayerDistance();
+		glm::vec3 getPlayerDirection();
+		inline EnemySquad* getSquad() { return squad_; };
+		// idle enemies only think every ENEMY_IDLE_THINK_TIME seconds, unless knocked back or following a squad
+		inline bool isAsleep() { return state == EnemyState::IDLE && !idle_think_timer.timesUp() && knockback_velocity == glm::vec3(0.0f) && (squad_ == nullptr || squad_->getLeader() == this); };
 
 		// setters
+		inline void sleep(double delta_time) { idle_think_timer.Update(delta_time); idle_frames_slept++; };
 		void takeDamage(float damage, glm::vec3 damage_position);
+		inline void setTargetPosition(glm::vec3 target_position) { this->target_position = target_position; };
+		inline void setSteering(EnemySteering* steering) { steering_ = steering; };
+		inline void setSteeringSlot(int slot) { steering_slot = slot; };
+		inline void setFlowField(FlowField* flow_field) { flow_field_ = flow_field; };
+		inline void setSquad(EnemySquad* squad) { squad_ = squad; };
+		inline void setFormationOffset(glm::vec3 offset) { formation_offset = offset; };
+		inline void setPlayerCache(PlayerRelativeCache* cache, int index) { player_cache_ = cache; player_cache_index = index; };
 
 		// identify
-		inline virtual bool isMeleeType() { return false; };
-		inline virtual bool isRangedType() { return false; };
-		inline virtual bool isChargeType() { return false; };
+		inline bool isMeleeType() { return type == EnemyType::MELEE_ENEMY; };
+		inline bool isRangedType() { return type == EnemyType::RANGED_ENEMY; };
+		inline bool isChargeType() { return type == EnemyType::CHARGE_ENEMY; };
+
+		// copy of this enemy, used to spawn from the prefab enemies Game builds once per type
+		virtual EnemyGameObject* clone() const { return new EnemyGameObject(*this); };
 
 		// engage action
+		// called through updateEnemy with the concrete type, so no virtual dispatch in the archetypes
 		virtual void engageAction(double delta_time);
 		virtual void charge(double delta_time);
 
 		// movement
+		// queued on the shared steering batch when one is set, applied immediately otherwise
 		void moveTowardsTarget(double delta_time, bool ram_into_target);
+		void moveTowards(double delta_time, glm::vec3 destination, bool ram_into_target);
+		// targets the player, moving along the shared flow field when one is set
+		void chasePlayer(double delta_time);
 		void turnTowardsTarget(double delta_time);
+		// turns towards where a projectile of the given speed would meet the player
+		void aimAtPlayer(double delta_time, float projectile_speed, float time_offset);
+
+		// squad
+		// holds formation and copies the leader's state, returns false once this member breaks off
+		bool followSquad(double delta_time);
 
 		// Helpers
 		bool isEnemy() override { return true; };
 
 		bool isFacingTarget(float max_angle_difference);
+		// calls facingTarget if the enemy faces its target to within max_angle_difference once this frame's turn is applied,
+		// which with batched steering is not until the flush
+		void whenFacingTarget(float max_angle_difference);
+		// called by the steering batch once it has moved and turned the enemy
+		void steeringApplied(void);
 		// finds the intersaction with the player given a start position and speed
 		// returns player movement destination if intersaction not found
 		glm::vec3 getPlayerSpeedIntersactionPoint(glm::vec3 start_position, float self_speed, float time_offset);	
-		inline virtual bool isCharging() { return false; };
-		inline virtual void stopCharging() {};
 
 	protected:
+		// squad following and the state machine, shared by every enemy type
+		// Self is the concrete type, its engageAction and charge are called without virtual dispatch
+		template <class Self>
+		void updateEnemy(Self* self, double delta_time);
+
 		EnemyType type;	// enemy type
 
 		EnemyState state = EnemyState::IDLE;	// enemy state
@@ -76,8 +120,118 @@ namespace game {
 		float alert_time = 5.0f;
 		Timer alert_timer;
 
+		Timer idle_think_timer;
+		int idle_frames_slept = 0;
+
+		// what the enemy does once whenFacingTarget finds it facing its target
+		virtual void facingTarget(void) {};
+
+		// batched steering
+		EnemySteering* steering_ = nullptr;
+		int steering_slot = -1;
+		float facing_check_angle = -1.0f;	// of a whenFacingTarget waiting for the flush, negative for none
+		FlowField* flow_field_ = nullptr;
+
+		// squad
+		EnemySquad* squad_ = nullptr;
+		glm::vec3 formation_offset = glm::vec3(0.0f);	// from the squad leader
+
+		// distance and direction to the player
+		PlayerRelativeCache* player_cache_ = nullptr;
+		int player_cache_index = -1;
+
 	}; // class EnemyGameObject
 
+
+	template <class Self>
+	void EnemyGameObject::updateEnemy(Self* self, double delta_time) {
+		// squad members follow the leader instead of running their own perception
+		if (squad_ != nullptr && squad_->getLeader() != this && followSquad(delta_time)) {
+			GameObject::Update(delta_time);
+			return;
+		}
+
+		// idle enemies between thinks only animate their children
+		if (isAsleep()) {
+			sleep(delta_time);
+			GameObject::Update(delta_time);
+			return;
+		}
+
+		glm::vec3 player_position = player_->GetPosition();
+		float player_distance = getPlayerDistance();
+
+		switch (state) {
+			
+		// Idle
+		case EnemyState::IDLE: {
+			// catch up on the wander rolls of the frames slept through
+			int rolls = idle_frames_slept + 1;
+			idle_frames_slept = 0;
+			idle_think_timer.setTime(ENEMY_IDLE_THINK_TIME);
+
+			if (player_distance <= idle_detection_radius) {	// detects player
+				state = EnemyState::ENGAGE;
+				target_position = player_->GetPosition();
+				break;
+			}
+
+			if (Helper::roll(100.0f * (1.0f - std::pow(1.0f - wander_chance / 100.0f, rolls)))) {
+				glm::vec3 target_displacement = Helper::generate2dPosition(-wander_range, wander_range, -wander_range, wander_range);
+				target_position = position_ + target_displacement;
+				state = EnemyState::WANDER;
+				break;
+			}
+			break;
+		}
+
+		// Wander
+		case EnemyState::WANDER:
+			if (player_distance <= idle_detection_radius) {	// detects player
+				state = EnemyState::ENGAGE;
+				target_position = player_->GetPosition();
+				break;
+			}
+			if (glm::length(target_position - GetPosition()) <= 0.05f) {		// arrived at target
+				state = EnemyState::IDLE;
+				break;
+			}
+			moveTowardsTarget(delta_time, false);
+			
+			break;
+
+		case EnemyState::ALERT:
+			alert_timer.Update(delta_time);
+			if (alert_timer.timesUp()) {
+				state = EnemyState::IDLE;
+				break;
+			}
+			if (player_distance <= alert_detection_radius) {	// detects player
+				state = EnemyState::ENGAGE;
+				target_position = player_->GetPosition();
+				break;
+			}
+			turnTowardsTarget(delta_time);
+			break;
+
+		// Engage
+		case EnemyState::ENGAGE:
+			self->Self::engageAction(delta_time);
+			if (player_distance > engage_detection_radius) {	// player leaves detect zone
+				state = EnemyState::WANDER;
+				break;
+			}
+			break;
+		
+		case EnemyState::CHARGE:
+			self->Self::charge(delta_time);
+			break;
+		}
+
+		GameObject::Update(delta_time);
+	}
+
+
 } // namespace game
 
 #endif
\ No newline at end of file
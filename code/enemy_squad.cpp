@@ -0,0 +1,42 @@
+#include <algorithm>
+
+#include "enemy_squad.h"
+#include "enemy_game_object.h"
+
+namespace game {
+
+	EnemySquad::EnemySquad(EnemyGameObject* leader) {
+		members_.push_back(leader);
+		leader->setSquad(this);
+	}
+
+
+	void EnemySquad::add(EnemyGameObject* enemy) {
+		EnemyGameObject* leader = getLeader();
+		if (leader != nullptr) {
+			enemy->setFormationOffset(enemy->GetPosition() - leader->GetPosition());
+		}
+		members_.push_back(enemy);
+		enemy->setSquad(this);
+	}
+
+
+	void EnemySquad::remove(EnemyGameObject* enemy) {
+		auto member = std::find(members_.begin(), members_.end(), enemy);
+		if (member == members_.end()) {
+			return;
+		}
+		bool was_leader = member == members_.begin();
+		members_.erase(member);
+		enemy->setSquad(nullptr);
+
+		// offsets are relative to the leader, so recentre them on a new one
+		if (was_leader && !members_.empty()) {
+			EnemyGameObject* leader = members_[0];
+			for (int i = 1; i < members_.size(); i++) {
+				members_[i]->setFormationOffset(members_[i]->GetPosition() - leader->GetPosition());
+			}
+		}
+	}
+
+} // namespace game
@@ -0,0 +1,39 @@
+#ifndef ENEMY_SQUAD_H_
+#define ENEMY_SQUAD_H_
+
+#include <vector>
+
+#include "config.h"
+
+namespace game {
+
+	class EnemyGameObject;
+
+	/*
+		EnemySquad groups enemies spawned near each other. The leader runs the full enemy AI,
+		the other members hold a formation offset around it and copy its state
+	*/
+	class EnemySquad {
+
+	public:
+		EnemySquad(EnemyGameObject* leader);
+
+		// adds a member, which keeps its current offset from the leader as its formation position
+		void add(EnemyGameObject* enemy);
+		// removes a member, the next member takes over if the leader is removed
+		void remove(EnemyGameObject* enemy);
+
+		// getters
+		inline EnemyGameObject* getLeader() { return members_.empty() ? nullptr : members_[0]; };
+		inline int getSize() { return static_cast<int>(members_.size()); };
+		inline bool isEmpty() { return members_.empty(); };
+		inline bool isFull() { return members_.size() >= SQUAD_SIZE; };
+
+	private:
+		std::vector<EnemyGameObject*> members_;	// leader first
+
+	}; // class EnemySquad
+
+} // namespace game
+
+#endif // ENEMY_SQUAD_H_
@@ -0,0 +1,223 @@
+#include <glm/gtc/constants.hpp>
+
+#include "enemy_steering.h"
+#include "enemy_game_object.h"
+#include "simd.h"
+
+namespace game {
+
+	void SteeringLanes::resize(int count) {
+		position_x.resize(count);
+		position_y.resize(count);
+		angle.resize(count);
+		target_x.resize(count);
+		target_y.resize(count);
+		speed.resize(count);
+		turn_speed.resize(count);
+		stop_angle.resize(count);
+		move_enabled.resize(count);
+		aim_speed.resize(count);
+		aim_time_offset.resize(count);
+	}
+
+
+	EnemySteering::EnemySteering() {}
+
+
+	int EnemySteering::queue(EnemyGameObject* enemy) {
+		int slot = enemy->getSteeringSlot();
+		if (slot < 0) {
+			slot = static_cast<int>(enemies_.size());
+			enemies_.push_back(enemy);
+			// lanes only ever grow, padded so the kernels can always read whole registers
+			if (simd::padded(slot + 1) > lanes_.position_x.size()) {
+				lanes_.resize(simd::padded(2 * slot + 1));
+			}
+			enemy->setSteeringSlot(slot);
+		}
+		lanes_.speed[slot] = enemy->getSpeed();
+		lanes_.turn_speed[slot] = enemy->getTurnSpeed();
+		lanes_.aim_speed[slot] = 0.0f;
+		lanes_.aim_time_offset[slot] = 0.0f;
+		return slot;
+	}
+
+
+	void EnemySteering::queueMove(EnemyGameObject* enemy, glm::vec3 target_position, bool ram_into_target) {
+		int slot = queue(enemy);
+		lanes_.target_x[slot] = target_position.x;
+		lanes_.target_y[slot] = target_position.y;
+		// ramming stops until 90 degrees to target, otherwise until facing target
+		lanes_.stop_angle[slot] = ram_into_target ? (glm::pi<float>() * 90 / 360) : 0.001f;
+		lanes_.move_enabled[slot] = 1.0f;
+	}
+
+
+	void EnemySteering::queueTurn(EnemyGameObject* enemy, glm::vec3 target_position) {
+		int slot = queue(enemy);
+		lanes_.target_x[slot] = target_position.x;
+		lanes_.target_y[slot] = target_position.y;
+		lanes_.stop_angle[slot] = 0.0f;
+		lanes_.move_enabled[slot] = 0.0f;
+	}
+
+
+	void EnemySteering::queueAim(EnemyGameObject* enemy, float projectile_speed, float time_offset) {
+		int slot = queue(enemy);
+		lanes_.stop_angle[slot] = 0.0f;
+		lanes_.move_enabled[slot] = 0.0f;
+		lanes_.aim_speed[slot] = projectile_speed;
+		lanes_.aim_time_offset[slot] = time_offset;
+	}
+
+
+	void EnemySteering::remove(EnemyGameObject* enemy) {
+		int slot = enemy->getSteeringSlot();
+		if (slot >= 0 && slot < enemies_.size() && enemies_[slot] == enemy) {
+			enemies_[slot] = nullptr;
+			enemy->setSteeringSlot(-1);
+		}
+	}
+
+
+	void EnemySteering::flush(double delta_time) {
+		int count = static_cast<int>(enemies_.size());
+		if (count == 0) {
+			return;
+		}
+
+		// padding lanes neither move nor aim
+		for (int i = count; i < simd::padded(count); i++) {
+			lanes_.move_enabled[i] = 0.0f;
+			lanes_.aim_speed[i] = 0.0f;
+		}
+
+		// gather current transforms (after knockback has been applied this frame)
+		for (int i = 0; i < count; i++) {
+			EnemyGameObject* enemy = enemies_[i];
+			if (enemy == nullptr) {
+				lanes_.move_enabled[i] = 0.0f;
+				lanes_.aim_speed[i] = 0.0f;
+				continue;
+			}
+			lanes_.position_x[i] = enemy->GetPosition().x;
+			lanes_.position_y[i] = enemy->GetPosition().y;
+			lanes_.angle[i] = enemy->GetRotation();
+		}
+
+		if (player_ != nullptr) {
+			glm::vec2 player_position = glm::vec2(player_->GetPosition().x, player_->GetPosition().y);
+			glm::vec2 player_velocity = glm::vec2(player_->GetVelocity().x, player_->GetVelocity().y);
+			interceptBatch(lanes_, count, player_position, player_velocity);
+		}
+		steerBatch(lanes_, count, static_cast<float>(delta_time));
+
+		// scatter results
+		for (int i = 0; i < count; i++) {
+			EnemyGameObject* enemy = enemies_[i];
+			if (enemy == nullptr) {
+				continue;
+			}
+			enemy->SetPosition(glm::vec3(lanes_.position_x[i], lanes_.position_y[i], enemy->GetPosition().z));
+			enemy->SetRotation(lanes_.angle[i]);
+			if (lanes_.aim_speed[i] > 0.0f) {
+				enemy->setTargetPosition(glm::vec3(lanes_.target_x[i], lanes_.target_y[i], 0.0f));
+			}
+			enemy->setSteeringSlot(-1);
+			enemy->steeringApplied();
+		}
+
+		enemies_.clear();
+	}
+
+
+	void EnemySteering::interceptBatch(SteeringLanes& lanes, int count, glm::vec2 player_position, glm::vec2 player_velocity) {
+		using namespace simd;
+
+		vfloat zero = set1(0.0f);
+		vfloat vx = set1(player_velocity.x);
+		vfloat vy = set1(player_velocity.y);
+		vfloat velocity_squared = set1(player_velocity.x * player_velocity.x + player_velocity.y * player_velocity.y);
+
+		for (int i = 0; i < count; i += SIMD_WIDTH) {
+			vfloat aim_speed = load(&lanes.aim_speed[i]);
+			vmask aiming = gt(aim_speed, zero);
+			if (!any(aiming)) {
+				continue;
+			}
+
+			// player position after the time offset
+			vfloat time_offset = load(&lanes.aim_time_offset[i]);
+			vfloat player_x = add(set1(player_position.x), mul(vx, time_offset));
+			vfloat player_y = add(set1(player_position.y), mul(vy, time_offset));
+			vfloat rx = sub(player_x, load(&lanes.position_x[i]));
+			vfloat ry = sub(player_y, load(&lanes.position_y[i]));
+
+			// solve |r + v t| = s t
+			vfloat a = sub(velocity_squared, mul(aim_speed, aim_speed));
+			vfloat b = mul(set1(2.0f), add(mul(vx, rx), mul(vy, ry)));
+			vfloat c = add(mul(rx, rx), mul(ry, ry));
+			vfloat root = sqrt(sub(mul(b, b), mul(set1(4.0f), mul(a, c))));
+			vfloat two_a = mul(set1(2.0f), a);
+			vfloat t1 = div(sub(root, b), two_a);
+			vfloat t2 = div(sub(negate(b), root), two_a);
+			vfloat t = max(t1, t2);
+
+			// no intersection: aim at where the player will be in a second
+			vmask hit = gt(t, zero);
+			t = select(hit, t, set1(1.0f));
+
+			vfloat target_x = add(player_x, mul(vx, t));
+			vfloat target_y = add(player_y, mul(vy, t));
+			store(&lanes.target_x[i], select(aiming, target_x, load(&lanes.target_x[i])));
+			store(&lanes.target_y[i], select(aiming, target_y, load(&lanes.target_y[i])));
+		}
+	}
+
+
+	void EnemySteering::steerBatch(SteeringLanes& lanes, int count, float delta_time) {
+		using namespace simd;
+
+		vfloat dt = set1(delta_time);
+
+		for (int i = 0; i < count; i += SIMD_WIDTH) {
+			vfloat position_x = load(&lanes.position_x[i]);
+			vfloat position_y = load(&lanes.position_y[i]);
+			vfloat angle = load(&lanes.angle[i]);
+			vfloat dx = sub(load(&lanes.target_x[i]), position_x);
+			vfloat dy = sub(load(&lanes.target_y[i]), position_y);
+
+			// bearing
+			vfloat bearing_sin, bearing_cos;
+			sincos(angle, &bearing_sin, &bearing_cos);
+
+			// signed angle from bearing to target with one atan2, already in [-pi, pi]
+			vfloat cross = sub(mul(bearing_cos, dy), mul(bearing_sin, dx));
+			vfloat dot = add(mul(bearing_cos, dx), mul(bearing_sin, dy));
+			vfloat angle_difference = atan2(cross, dot);
+
+			// turn, clamped to the turn speed
+			vfloat angle_displacement = mul(load(&lanes.turn_speed[i]), dt);
+			vfloat turn = min(max(angle_difference, negate(angle_displacement)), angle_displacement);
+			store(&lanes.angle[i], wrap_positive(add(angle, turn)));
+
+			// radius of the turn if current speed and turn speed is used
+			// step * sin(base_angle) / sin(displacement) simplifies to step / (2 sin(displacement / 2))
+			vfloat step = mul(load(&lanes.speed[i]), dt);
+			vfloat half_sin, half_cos;
+			sincos(mul(angle_displacement, set1(0.5f)), &half_sin, &half_cos);
+			vfloat turn_radius = div(step, mul(set1(2.0f), half_sin));
+
+			// stop moving if unable to reach target by current turning speed
+			vfloat target_distance = sqrt(add(mul(dx, dx), mul(dy, dy)));
+			vmask stop = mask_and(gt(turn_radius, target_distance), ge(abs(angle_difference), load(&lanes.stop_angle[i])));
+			vfloat travel = select(stop, set1(0.0f), min(target_distance, step));
+			travel = mul(travel, load(&lanes.move_enabled[i]));
+
+			// move along the bearing from before the turn
+			store(&lanes.position_x[i], add(position_x, mul(bearing_cos, travel)));
+			store(&lanes.position_y[i], add(position_y, mul(bearing_sin, travel)));
+		}
+	}
+
+} // namespace game
@@ -0,0 +1,73 @@
+#ifndef ENEMY_STEERING_H_
+#define ENEMY_STEERING_H_
+
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace game {
+
+	class EnemyGameObject;
+	class PlayerGameObject;
+
+	// Packed per-enemy steering data, one entry per lane
+	// Arrays are padded to a whole number of SIMD registers
+	struct SteeringLanes {
+		std::vector<float> position_x;
+		std::vector<float> position_y;
+		std::vector<float> angle;
+		std::vector<float> target_x;
+		std::vector<float> target_y;
+		std::vector<float> speed;
+		std::vector<float> turn_speed;
+		std::vector<float> stop_angle;		// stop moving while further off target than this (if the target is inside the turn radius)
+		std::vector<float> move_enabled;	// 1 to move, 0 to only turn
+		std::vector<float> aim_speed;		// > 0 to aim at the player intercept point instead of the target
+		std::vector<float> aim_time_offset;
+
+		void resize(int count);
+	};
+
+	/*
+		EnemySteering collects the turn, move and aim requests enemies make during their update,
+		then runs them all at once over packed arrays with SIMD kernels (AVX, SSE2 or scalar fallback)
+	*/
+	class EnemySteering {
+
+	public:
+		EnemySteering();
+
+		inline void setPlayer(PlayerGameObject* player) { player_ = player; };
+
+		// Queue requests for this frame, a later request from the same enemy replaces the earlier one
+		void queueMove(EnemyGameObject* enemy, glm::vec3 target_position, bool ram_into_target);
+		void queueTurn(EnemyGameObject* enemy, glm::vec3 target_position);
+		void queueAim(EnemyGameObject* enemy, float projectile_speed, float time_offset);
+
+		// Forget a request, used when an enemy is deleted before the flush
+		void remove(EnemyGameObject* enemy);
+
+		// Run the kernels and write positions, rotations and aim targets back to the enemies
+		void flush(double delta_time);
+
+		inline int getQueuedCount() { return static_cast<int>(enemies_.size()); };
+
+		// Kernels, public so they can be benchmarked against the scalar EnemyGameObject path
+
+		// writes the player intercept point into target_x/y of every lane with aim_speed > 0
+		static void interceptBatch(SteeringLanes& lanes, int count, glm::vec2 player_position, glm::vec2 player_velocity);
+		// turns every lane towards its target and moves it along its old bearing
+		static void steerBatch(SteeringLanes& lanes, int count, float delta_time);
+
+	private:
+		int queue(EnemyGameObject* enemy);
+
+		PlayerGameObject* player_ = nullptr;
+
+		std::vector<EnemyGameObject*> enemies_;
+		SteeringLanes lanes_;
+
+	}; // class EnemySteering
+
+} // namespace game
+
+#endif // ENEMY_STEERING_H_
@@ -0,0 +1,69 @@
+#ifndef ENEMY_TRAITS_H_
+#define ENEMY_TRAITS_H_
+
+#include "config.h"
+
+namespace game {
+
+	// Compile time tuning values for each enemy type, read from the config.h defines
+	template <EnemyType Type>
+	struct EnemyTraits;
+
+	template <>
+	struct EnemyTraits<EnemyType::MELEE_ENEMY> {
+		static constexpr float size = MELEE_ENEMY_SIZE;
+		static constexpr float health = MELEE_ENEMY_HEALTH;
+		static constexpr float melee_damage = MELEE_ENEMY_MELEE_DAMAGE;
+		static constexpr float weight = MELEE_ENEMY_WEIGHT;
+		static constexpr float idle_detection_radius = MELEE_ENEMY_IDLE_DETECTION_RADIUS;
+		static constexpr float engage_detection_radius = MELEE_ENEMY_ENGAGE_DETECTION_RADIUS;
+		static constexpr float speed = MELEE_ENEMY_SPEED;
+		static constexpr float turn_speed = MELEE_ENEMY_TURN_SPEED;	// in radians
+		static constexpr float wander_chance = MELEE_ENEMY_WANDER_CHANCE;
+		static constexpr float wander_range = MELEE_ENEMY_WANDER_RANGE;
+	};
+
+	template <>
+	struct EnemyTraits<EnemyType::RANGED_ENEMY> {
+		static constexpr float size = RANGED_ENEMY_SIZE;
+		static constexpr float health = RANGED_ENEMY_HEALTH;
+		static constexpr float melee_damage = RANGED_ENEMY_MELEE_DAMAGE;
+		static constexpr float weight = RANGED_ENEMY_WEIGHT;
+		static constexpr float idle_detection_radius = RANGED_ENEMY_IDLE_DETECTION_RADIUS;
+		static constexpr float engage_detection_radius = RANGED_ENEMY_ENGAGE_DETECTION_RADIUS;
+		static constexpr float speed = RANGED_ENEMY_SPEED;
+		static constexpr float turn_speed = RANGED_ENEMY_TURN_SPEED;	// in radians
+		static constexpr float wander_chance = RANGED_ENEMY_WANDER_CHANCE;
+		static constexpr float wander_range = RANGED_ENEMY_WANDER_RANGE;
+
+		static constexpr float min_engage_range = RANGED_ENEMY_MIN_ENGAGE_RANGE;
+		static constexpr float max_engage_range = RANGED_ENEMY_MAX_ENGAGE_RANGE;
+		static constexpr float rate_of_fire = RANGED_ENEMY_RATE_OF_FIRE;
+	};
+
+	template <>
+	struct EnemyTraits<EnemyType::CHARGE_ENEMY> {
+		static constexpr float size = CHARGE_ENEMY_SIZE;
+		static constexpr float health = CHARGE_ENEMY_HEALTH;
+		static constexpr float melee_damage = CHARGE_ENEMY_MELEE_DAMAGE;
+		static constexpr float weight = CHARGE_ENEMY_WEIGHT;
+		static constexpr float idle_detection_radius = CHARGE_ENEMY_IDLE_DETECTION_RADIUS;
+		static constexpr float engage_detection_radius = CHARGE_ENEMY_ENGAGE_DETECTION_RADIUS;
+		static constexpr float speed = CHARGE_ENEMY_SPEED;
+		static constexpr float turn_speed = CHARGE_ENEMY_TURN_SPEED;	// in radians
+		static constexpr float wander_chance = CHARGE_ENEMY_WANDER_CHANCE;
+		static constexpr float wander_range = CHARGE_ENEMY_WANDER_RANGE;
+
+		static constexpr float charge_range = CHARGE_ENEMY_CHARGE_RANGE;
+		static constexpr float charge_prepare_time = CHARGE_ENEMY_CHARGE_PREPARE_TIME;	// seconds
+		static constexpr float charge_time = CHARGE_ENEMY_CHARGE_TIME;	// seconds
+		static constexpr float charge_cooldown_time = CHARGE_ENEMY_CHARGE_COOLDOWN_TIME;	// seconds
+		static constexpr float charge_speed = CHARGE_ENEMY_CHARGE_SPEED;
+		static constexpr float charge_damage = CHARGE_ENEMY_CHARGE_DAMAGE;
+		static constexpr float max_engage_range = CHARGE_ENEMY_MAX_ENGAGE_RANGE;
+		static constexpr float rate_of_fire = CHARGE_ENEMY_RATE_OF_FIRE;
+	};
+
+} // namespace game
+
+#endif // ENEMY_TRAITS_H_
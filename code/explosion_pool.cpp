@@ -0,0 +1,51 @@
+#include "explosion_pool.h"
+#include "gl_stats.h"
+
+namespace game {
+
+    ExplosionPool::ExplosionPool(void) : records_(MAX_EXPLOSIONS) {}
+
+
+    void ExplosionPool::Init(ParticleSystem* explosion, Shader* instanced_shader)
+    {
+        batch_.Init(explosion->getGeometry(), instanced_shader, explosion->getTexture());
+        cycle_ = explosion->getCycle();
+        speed_ = explosion->getSpeed();
+    }
+
+
+    void ExplosionPool::spawn(glm::vec3 position, float scale, double current_time)
+    {
+        // replace the oldest explosion when full
+        if (count_ == MAX_EXPLOSIONS) {
+            head_ = (head_ + 1) % MAX_EXPLOSIONS;
+            count_--;
+        }
+
+        records_[(head_ + count_) % MAX_EXPLOSIONS] = { position, scale, current_time };
+        count_++;
+    }
+
+
+    void ExplosionPool::Update(double current_time)
+    {
+        // an explosion lasts one cycle
+        while (count_ > 0 && current_time - records_[head_].start_time >= cycle_) {
+            head_ = (head_ + 1) % MAX_EXPLOSIONS;
+            count_--;
+        }
+    }
+
+
+    void ExplosionPool::Render(double current_time)
+    {
+        GL_STATS_SCOPE("ExplosionPool::Render");
+        for (int i = 0; i < count_; i++) {
+            const Record& record = records_[(head_ + i) % MAX_EXPLOSIONS];
+            batch_.add({ record.position.x, record.position.y, 0.0f, record.scale, static_cast<float>(record.start_time), cycle_, speed_ });
+        }
+
+        batch_.Render(current_time);
+    }
+
+} // namespace game
@@ -0,0 +1,57 @@
+#ifndef EXPLOSION_POOL_H_
+#define EXPLOSION_POOL_H_
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "config.h"
+#include "particle_batch.h"
+#include "particle_system.h"
+
+namespace game {
+
+    /*
+        ExplosionPool keeps every active explosion as a plain record in a fixed ring of MAX_EXPLOSIONS
+        Every explosion lasts one cycle of the explosion particles and they start in order, so they end first in, first out
+        All of them are drawn in one instanced call, with their start time, cycle and speed per instance
+        When the pool is full, the oldest explosion is replaced
+    */
+    class ExplosionPool {
+
+    public:
+        ExplosionPool(void);
+
+        // Call once there is an OpenGL context, the explosion's geometry, texture, cycle and speed are shared by every explosion, drawn with the instanced shader variant for its type
+        void Init(ParticleSystem* explosion, Shader* instanced_shader);
+
+        // Starts an explosion at current_time
+        void spawn(glm::vec3 position, float scale, double current_time);
+
+        // Drops the explosions that have finished
+        void Update(double current_time);
+
+        // Draws every active explosion
+        void Render(double current_time);
+
+        inline int getCount(void) const { return count_; };
+
+    private:
+        struct Record {
+            glm::vec3 position;
+            float scale;
+            double start_time;
+        };
+
+        std::vector<Record> records_;
+        int head_ = 0;
+        int count_ = 0;
+
+        ParticleBatch batch_;
+        float cycle_ = 1.0f;
+        float speed_ = 1.0f;
+
+    }; // class ExplosionPool
+
+} // namespace game
+
+#endif // EXPLOSION_POOL_H_
@@ -0,0 +1,184 @@
+#include <algorithm>
+
+#include "feedback_particle_system.h"
+#include "gl_state.h"
+#include "gl_stats.h"
+#include "helper.h"
+
+namespace game {
+
+    FeedbackParticleSystem::FeedbackParticleSystem(void) {}
+
+
+    FeedbackParticleSystem::~FeedbackParticleSystem() {
+        if (buffers_[0] != 0) {
+            GLState::DeleteBuffers(2, buffers_);
+            GLState::DeleteBuffers(1, &quad_vbo_);
+            GLState::DeleteBuffers(1, &quad_ebo_);
+        }
+    }
+
+
+    void FeedbackParticleSystem::Init(Shader* update_shader, Shader* render_shader, GLuint texture) {
+        update_shader_ = update_shader;
+        render_shader_ = render_shader;
+        texture_ = texture;
+
+        // both particle buffers start with every slot dead
+        std::vector<Particle> empty(MAX_SIMULATED_PARTICLES, Particle{});
+        glGenBuffers(2, buffers_);
+        for (int i = 0; i < 2; i++) {
+            GLState::BindBuffer(GL_ARRAY_BUFFER, buffers_[i]);
+            glBufferData(GL_ARRAY_BUFFER, empty.size() * sizeof(Particle), empty.data(), GL_DYNAMIC_COPY);
+        }
+
+        // one quad, as in Sprite
+        GLfloat quad[] = {
+            // Position      Texture coordinates
+            -0.5f,  0.5f,    0.0f, 0.0f, // Top-left
+             0.5f,  0.5f,    1.0f, 0.0f, // Top-right
+             0.5f, -0.5f,    1.0f, 1.0f, // Bottom-right
+            -0.5f, -0.5f,    0.0f, 1.0f  // Bottom-left
+        };
+        GLuint face[] = {
+            0, 1, 2, // t1
+            2, 3, 0  // t2
+        };
+        glGenBuffers(1, &quad_vbo_);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, quad_vbo_);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+        glGenBuffers(1, &quad_ebo_);
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad_ebo_);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(face), face, GL_STATIC_DRAW);
+    }
+
+
+    void FeedbackParticleSystem::burst(const ParticleEmitter& emitter, int count) {
+        count = std::min(count, MAX_SIMULATED_PARTICLES);
+        if (count <= 0) {
+            return;
+        }
+
+        burst_.resize(count);
+        for (int i = 0; i < count; i++) {
+            float angle = emitter.direction + Helper::generateFloat(-0.5f, 0.5f) * emitter.spread;
+            float speed = Helper::generateFloat(emitter.min_speed, emitter.max_speed);
+            burst_[i] = {
+                { emitter.position.x, emitter.position.y },
+                { glm::cos(angle) * speed, glm::sin(angle) * speed },
+                { emitter.lifetime, emitter.lifetime },
+                { emitter.drag, emitter.gravity, emitter.size }
+            };
+        }
+
+        // write into the buffer the next update reads, wrapping around the ring
+        // until the ring first wraps the burst lands past slot_count_, which neither buffer has simulated yet
+        GLState::BindBuffer(GL_ARRAY_BUFFER, buffers_[source_]);
+        int first = std::min(count, MAX_SIMULATED_PARTICLES - next_slot_);
+        glBufferSubData(GL_ARRAY_BUFFER, next_slot_ * sizeof(Particle), first * sizeof(Particle), burst_.data());
+        if (first < count) {
+            glBufferSubData(GL_ARRAY_BUFFER, 0, (count - first) * sizeof(Particle), burst_.data() + first);
+        }
+
+        next_slot_ = (next_slot_ + count) % MAX_SIMULATED_PARTICLES;
+        slot_count_ = std::min(slot_count_ + count, MAX_SIMULATED_PARTICLES);
+    }
+
+
+    void FeedbackParticleSystem::SetParticleAttributes(GLuint program, GLuint buffer, GLuint divisor) {
+        GLState::BindBuffer(GL_ARRAY_BUFFER, buffer);
+
+        const char* names[] = { "position", "velocity", "life", "properties" };
+        const int sizes[] = { 2, 2, 2, 3 };
+        int offset = 0;
+        for (int i = 0; i < 4; i++) {
+            GLint att = glGetAttribLocation(program, names[i]);
+            // the render shader does not read the velocity
+            if (att >= 0) {
+                glVertexAttribPointer(att, sizes[i], GL_FLOAT, GL_FALSE, sizeof(Particle), (void*)(offset * sizeof(GLfloat)));
+                glEnableVertexAttribArray(att);
+                glVertexAttribDivisor(att, divisor);
+            }
+            offset += sizes[i];
+        }
+    }
+
+
+    void FeedbackParticleSystem::ResetParticleAttributes(GLuint program) {
+        const char* names[] = { "position", "velocity", "life", "properties" };
+        for (int i = 0; i < 4; i++) {
+            GLint att = glGetAttribLocation(program, names[i]);
+            if (att >= 0) {
+                glVertexAttribDivisor(att, 0);
+                glDisableVertexAttribArray(att);
+            }
+        }
+    }
+
+
+    void FeedbackParticleSystem::Update(double delta_time) {
+        if (slot_count_ == 0) {
+            return;
+        }
+        GL_STATS_SCOPE("FeedbackParticleSystem::Update");
+
+        int target = 1 - source_;
+
+        update_shader_->Enable();
+        update_shader_->SetUniform1f("delta_time", static_cast<float>(delta_time));
+        SetParticleAttributes(update_shader_->GetShaderProgram(), buffers_[source_], 0);
+
+        // one point per particle, captured into the other buffer without rasterizing anything
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, buffers_[target]);
+        glEnable(GL_RASTERIZER_DISCARD);
+        glBeginTransformFeedback(GL_POINTS);
+        GLStats::DrawArrays(GL_POINTS, 0, slot_count_);
+        glEndTransformFeedback();
+        glDisable(GL_RASTERIZER_DISCARD);
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+
+        ResetParticleAttributes(update_shader_->GetShaderProgram());
+
+        source_ = target;
+    }
+
+
+    void FeedbackParticleSystem::Render(void) {
+        if (slot_count_ == 0) {
+            return;
+        }
+        GL_STATS_SCOPE("FeedbackParticleSystem::Render");
+
+        GLuint program = render_shader_->GetShaderProgram();
+
+        // Set up the shader
+        render_shader_->Enable();
+
+        // Set blending, as Particles does
+        GLState::SetDepthTest(false);
+        GLState::SetBlend(true);
+        GLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE);
+
+        // The quad, per vertex
+        GLState::BindBuffer(GL_ARRAY_BUFFER, quad_vbo_);
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad_ebo_);
+        GLint vertex_att = glGetAttribLocation(program, "vertex");
+        glVertexAttribPointer(vertex_att, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
+        glEnableVertexAttribArray(vertex_att);
+        GLint tex_att = glGetAttribLocation(program, "uv");
+        glVertexAttribPointer(tex_att, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (void*)(2 * sizeof(GLfloat)));
+        glEnableVertexAttribArray(tex_att);
+
+        // The particles, per instance
+        SetParticleAttributes(program, buffers_[source_], 1);
+
+        // Bind the particle texture
+        GLState::BindTexture(texture_);
+
+        // Draw every slot, dead particles collapse to a point in the shader
+        GLStats::DrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, slot_count_);
+
+        ResetParticleAttributes(program);
+    }
+
+} // namespace game
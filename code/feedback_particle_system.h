@@ -0,0 +1,79 @@
+#ifndef FEEDBACK_PARTICLE_SYSTEM_H_
+#define FEEDBACK_PARTICLE_SYSTEM_H_
+
+#include <vector>
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "config.h"
+#include "particle_simulator.h"
+#include "shader.h"
+
+namespace game {
+
+    /*
+        FeedbackParticleSystem keeps every particle in GL buffers and advances them on the GPU
+        Each update runs particle_feedback_vertex_shader.glsl once per particle and captures its outputs with transform feedback
+        into the second buffer, then the two buffers swap; rendering instances a quad per particle straight from the new one
+        The CPU only writes the particles of a burst, into a ring of MAX_SIMULATED_PARTICLES slots that overwrites the oldest
+        Same emitters and motion as ParticleSimulator, needs OpenGL 3.3 for glDrawElementsInstanced (3.1) and glVertexAttribDivisor (3.3)
+    */
+    class FeedbackParticleSystem {
+
+    public:
+        FeedbackParticleSystem(void);
+        ~FeedbackParticleSystem();
+
+        // Call once there is an OpenGL context
+        // update_shader is particle_feedback_vertex_shader.glsl, render_shader is the particle_feedback_render_vertex_shader.glsl variant for the particle type
+        void Init(Shader* update_shader, Shader* render_shader, GLuint texture);
+
+        // Spawns count particles at once with the emitter's settings
+        void burst(const ParticleEmitter& emitter, int count);
+
+        // Advances every particle on the GPU
+        void Update(double delta_time);
+
+        // Draws every live particle
+        void Render(void);
+
+        // Slots simulated each update, live or not, since dead particles are only known to the GPU
+        inline int getCount(void) const { return slot_count_; };
+
+    private:
+        // One particle in the buffers, in the order the update shader captures its outputs
+        struct Particle {
+            float position[2];
+            float velocity[2];
+            float life[2];          // seconds left, lifetime
+            float properties[3];    // drag, gravity, size
+        };
+
+        // Points the particle attributes of the bound shader at buffer, advancing once per divisor instances
+        void SetParticleAttributes(GLuint program, GLuint buffer, GLuint divisor);
+        void ResetParticleAttributes(GLuint program);
+
+        Shader* update_shader_ = nullptr;
+        Shader* render_shader_ = nullptr;
+        GLuint texture_ = 0;
+
+        // Particle buffers, the update reads source_ and writes the other
+        GLuint buffers_[2] = { 0, 0 };
+        int source_ = 0;
+
+        // Ring of slots bursts write to
+        int next_slot_ = 0;
+        int slot_count_ = 0;
+
+        // Quad drawn for each particle
+        GLuint quad_vbo_ = 0;
+        GLuint quad_ebo_ = 0;
+
+        std::vector<Particle> burst_;   // scratch
+
+    }; // class FeedbackParticleSystem
+
+} // namespace game
+
+#endif // FEEDBACK_PARTICLE_SYSTEM_H_
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "flow_field.h"
+
+namespace game {
+
+	FlowField::FlowField()
+		: headings_(FLOW_FIELD_SIZE * FLOW_FIELD_SIZE), occupancy_(FLOW_FIELD_SIZE * FLOW_FIELD_SIZE, 0) {}
+
+
+	void FlowField::Update(glm::vec3 player_position, const std::vector<GameObject*>& enemies) {
+		// rebuild headings only when the player enters a new cell
+		int cell_x = static_cast<int>(std::floor(player_position.x / FLOW_FIELD_CELL_SIZE));
+		int cell_y = static_cast<int>(std::floor(player_position.y / FLOW_FIELD_CELL_SIZE));
+		if (!built || cell_x != player_cell_x || cell_y != player_cell_y) {
+			player_cell_x = cell_x;
+			player_cell_y = cell_y;
+			origin_ = glm::vec2(cell_x - FLOW_FIELD_SIZE / 2, cell_y - FLOW_FIELD_SIZE / 2) * FLOW_FIELD_CELL_SIZE;
+			rebuildHeadings(player_position);
+			built = true;
+		}
+
+		// count enemies per cell
+		std::fill(occupancy_.begin(), occupancy_.end(), 0);
+		for (int i = 0; i < enemies.size(); i++) {
+			int index = cellIndex(enemies[i]->GetPosition());
+			if (index >= 0) {
+				occupancy_[index]++;
+			}
+		}
+	}
+
+
+	bool FlowField::sample(glm::vec3 position, glm::vec3* heading) {
+		if (!built) {
+			return false;
+		}
+
+		int index = cellIndex(position);
+		if (index < 0) {
+			return false;
+		}
+		int x = index % FLOW_FIELD_SIZE;
+		int y = index / FLOW_FIELD_SIZE;
+
+		// close to the player the cell heading is too coarse
+		int player_x = FLOW_FIELD_SIZE / 2;
+		int player_y = FLOW_FIELD_SIZE / 2;
+		if (abs(x - player_x) <= FLOW_FIELD_DIRECT_RANGE && abs(y - player_y) <= FLOW_FIELD_DIRECT_RANGE) {
+			return false;
+		}
+
+		// separation, away from the more crowded neighbours
+		glm::vec2 separation = glm::vec2(occupancyAt(x - 1, y) - occupancyAt(x + 1, y), occupancyAt(x, y - 1) - occupancyAt(x, y + 1));
+
+		glm::vec2 direction = headings_[index] + separation * FLOW_FIELD_SEPARATION_WEIGHT;
+		float length = glm::length(direction);
+		if (length <= 0.0f) {
+			direction = headings_[index];
+		} else {
+			direction /= length;
+		}
+
+		*heading = glm::vec3(direction, 0.0f);
+		return true;
+	}
+
+
+	int FlowField::cellIndex(glm::vec3 position) {
+		int x = static_cast<int>(std::floor((position.x - origin_.x) / FLOW_FIELD_CELL_SIZE));
+		int y = static_cast<int>(std::floor((position.y - origin_.y) / FLOW_FIELD_CELL_SIZE));
+		if (x < 0 || x >= FLOW_FIELD_SIZE || y < 0 || y >= FLOW_FIELD_SIZE) {
+			return -1;
+		}
+		return y * FLOW_FIELD_SIZE + x;
+	}
+
+
+	int FlowField::occupancyAt(int x, int y) {
+		if (x < 0 || x >= FLOW_FIELD_SIZE || y < 0 || y >= FLOW_FIELD_SIZE) {
+			return 0;
+		}
+		return occupancy_[y * FLOW_FIELD_SIZE + x];
+	}
+
+
+	void FlowField::rebuildHeadings(glm::vec3 player_position) {
+		glm::vec2 player = glm::vec2(player_position.x, player_position.y);
+
+		for (int y = 0; y < FLOW_FIELD_SIZE; y++) {
+			for (int x = 0; x < FLOW_FIELD_SIZE; x++) {
+				glm::vec2 cell_centre = origin_ + (glm::vec2(x, y) + 0.5f) * FLOW_FIELD_CELL_SIZE;
+				glm::vec2 to_player = player - cell_centre;
+				float length = glm::length(to_player);
+				headings_[y * FLOW_FIELD_SIZE + x] = length > 0.0f ? to_player / length : glm::vec2(0.0f);
+			}
+		}
+	}
+
+} // namespace game
@@ -0,0 +1,49 @@
+#ifndef FLOW_FIELD_H_
+#define FLOW_FIELD_H_
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "config.h"
+
+#include "game_object.h"
+
+namespace game {
+
+	/*
+		FlowField is a grid centred on the player that stores, per cell, the heading towards the player
+		and how many enemies are in it. Engaged enemies sample it for their heading instead of all
+		steering straight at the player, and are pushed away from crowded cells
+	*/
+	class FlowField {
+
+	public:
+		FlowField();
+
+		// Recount occupancy, once per frame. Headings are only rebuilt when the player crosses a cell
+		void Update(glm::vec3 player_position, const std::vector<GameObject*>& enemies);
+
+		// Heading for an enemy at this position
+		// returns false outside the grid or close to the player, where enemies should steer directly
+		bool sample(glm::vec3 position, glm::vec3* heading);
+
+	private:
+		// cell index of a position, -1 if outside the grid
+		int cellIndex(glm::vec3 position);
+		int occupancyAt(int x, int y);
+		void rebuildHeadings(glm::vec3 player_position);
+
+		std::vector<glm::vec2> headings_;
+		std::vector<int> occupancy_;
+
+		int player_cell_x = 0;
+		int player_cell_y = 0;
+		bool built = false;
+
+		glm::vec2 origin_;	// world position of the corner of cell (0, 0)
+
+	}; // class FlowField
+
+} // namespace game
+
+#endif // FLOW_FIELD_H_
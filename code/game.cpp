@@ -1,14 +1,21 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <vector>
 #define GLM_FORCE_RADIANS
 #include <glm/gtc/matrix_transform.hpp> 
-#include <SOIL/SOIL.h>
 #include <iostream>
 
 #include <path_config.h>
 
 #include "game.h"
+#include "gl_state.h"
+#include "gl_stats.h"
+#include "texture_loader.h"
 
 namespace game {
 
@@ -31,37 +38,49 @@ Game::Game(void)
 }
 
 
-void Game::Init(void)
+void Game::Init(bool headless)
 {
 
-    // Initialize the window management library (GLFW)
-    if (!glfwInit()) {
-        throw(std::runtime_error(std::string("Could not initialize the GLFW library")));
-    }
+    if (headless) {
+        // Make a context current without a window, frames are drawn into a framebuffer object
+        headless_context_.Init();
+    } else {
+        // Initialize the window management library (GLFW)
+        if (!glfwInit()) {
+            throw(std::runtime_error(std::string("Could not initialize the GLFW library")));
+        }
 
-    // Set whether window can be resized
-    glfwWindowHint(GLFW_RESIZABLE, GL_TRUE); 
+        // Set whether window can be resized
+        glfwWindowHint(GLFW_RESIZABLE, GL_TRUE); 
 
-    // Create a window and its OpenGL context
-    window_ = glfwCreateWindow(window_width_g, window_height_g, window_title_g, NULL, NULL);
-    if (!window_) {
-        glfwTerminate();
-        throw(std::runtime_error(std::string("Could not create window")));
-    }
+        // Create a window and its OpenGL context
+        window_ = glfwCreateWindow(window_width_g, window_height_g, window_title_g, NULL, NULL);
+        if (!window_) {
+            glfwTerminate();
+            throw(std::runtime_error(std::string("Could not create window")));
+        }
 
-    // Make the window's OpenGL context the current one
-    glfwMakeContextCurrent(window_);
+        // Make the window's OpenGL context the current one
+        glfwMakeContextCurrent(window_);
+    }
 
     // Initialize the GLEW library to access OpenGL extensions
     // Need to do it after initializing an OpenGL context
     glewExperimental = GL_TRUE;
     GLenum err = glewInit();
-    if (err != GLEW_OK) {
+    bool glew_initialized = err == GLEW_OK;
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // GLEW built for GLX also looks for an X display, which a headless context neither has nor needs
+    glew_initialized = glew_initialized || (headless && err == GLEW_ERROR_NO_GLX_DISPLAY);
+#endif
+    if (!glew_initialized) {
         throw(std::runtime_error(std::string("Could not initialize the GLEW library: ") + std::string((const char *)glewGetErrorString(err))));
     }
 
     // Set event callbacks
-    glfwSetFramebufferSizeCallback(window_, ResizeCallback);
+    if (window_) {
+        glfwSetFramebufferSizeCallback(window_, ResizeCallback);
+    }
 
     // Initialize sprite geometry
     sprite_ = new Sprite();
@@ -82,11 +101,36 @@ void Game::Init(void)
     health_bar_sprite_ = new HealthBarSprite();
     health_bar_sprite_->CreateGeometry();
 
-    // Initialize the various shaders
-    sprite_shader_.Init((resources_directory_g+std::string("/sprite_vertex_shader.glsl")).c_str(), (resources_directory_g+std::string("/sprite_fragment_shader.glsl")).c_str());
-    particle_shader_.Init((resources_directory_g + std::string("/particle_vertex_shader.glsl")).c_str(), (resources_directory_g + std::string("/particle_fragment_shader.glsl")).c_str());
-    ui_shader_.Init((resources_directory_g+std::string("/ui_vertex_shader.glsl")).c_str(), (resources_directory_g+std::string("/ui_fragment_shader.glsl")).c_str());
-    text_shader_.Init((resources_directory_g+std::string("/sprite_vertex_shader.glsl")).c_str(), (resources_directory_g+std::string("/text_fragment_shader.glsl")).c_str());
+    // Share the camera between every shader, and stream the transforms of instanced batches, which need attribute divisors
+    // (OpenGL 3.3); without them each object of a batch is drawn on its own
+    camera_.Init();
+    TransformStream* transforms = nullptr;
+    if (GLEW_VERSION_3_3) {
+        transforms_.Init();
+        transforms = &transforms_;
+    }
+    shaders_.Init(resources_directory_g, &camera_, transforms);
+
+    // Initialize the various shaders, with a variant for each particle type and ui element
+    // Sources shared by several of them, like the sprite vertex shader, compile once per set of defines
+    sprite_shader_ = shaders_.Get("/sprite_vertex_shader.glsl", "/sprite_fragment_shader.glsl");
+    explosion_shader_ = shaders_.Get("/particle_vertex_shader.glsl", "/particle_fragment_shader.glsl", { "EXPLOSION_PARTICLE" });
+    bullet_particle_shader_ = shaders_.Get("/particle_vertex_shader.glsl", "/particle_fragment_shader.glsl", { "BULLET_PARTICLE" });
+    explosion_instanced_shader_ = shaders_.Get("/particle_instanced_vertex_shader.glsl", "/particle_fragment_shader.glsl", { "EXPLOSION_PARTICLE" });
+    trail_instanced_shader_ = shaders_.Get("/particle_instanced_vertex_shader.glsl", "/particle_fragment_shader.glsl", { "BULLET_PARTICLE" });
+    particle_stream_shader_ = shaders_.Get("/particle_stream_vertex_shader.glsl", "/particle_fragment_shader.glsl", { "EXPLOSION_PARTICLE" });
+    gpu_particles_ = USE_GPU_PARTICLES && GLEW_VERSION_3_3;
+    if (gpu_particles_) {
+        particle_feedback_shader_ = shaders_.GetFeedback("/particle_feedback_vertex_shader.glsl", { "feedback_position", "feedback_velocity", "feedback_life", "feedback_properties" });
+        particle_feedback_render_shader_ = shaders_.Get("/particle_feedback_render_vertex_shader.glsl", "/particle_fragment_shader.glsl", { "EXPLOSION_PARTICLE" });
+    }
+    if (USE_REDUCED_RESOLUTION_PARTICLES) {
+        particle_composite_shader_ = shaders_.Get("/particle_composite_vertex_shader.glsl", "/particle_composite_fragment_shader.glsl");
+        particle_target_.Init(particle_composite_shader_, PARTICLE_RESOLUTION_DIVISOR);
+    }
+    ui_shader_ = shaders_.Get("/ui_vertex_shader.glsl", "/ui_fragment_shader.glsl");
+    health_bar_shader_ = shaders_.Get("/ui_vertex_shader.glsl", "/ui_fragment_shader.glsl", { "HEALTH_BAR" });
+    text_shader_ = shaders_.Get("/sprite_vertex_shader.glsl", "/text_fragment_shader.glsl");
 
     // Initialize game state
     state_ = START_SCREEN;
@@ -106,12 +150,15 @@ Game::~Game()
     delete background_sprite_;
     delete health_bar_sprite_;
     for (int i = 0; i < game_objects_.size(); i++){
-        std::vector <GameObject*> current_vector = *game_objects_[i];
+        std::vector <GameObject*>& current_vector = *game_objects_[i];
         for (int j = 0; j < current_vector.size(); j++) {
             if (current_vector[j] != nullptr || current_vector[j] != NULL)
                 delete current_vector[j];
         }
     }
+    for (int i = 0; i < squads_.size(); i++) {
+        delete squads_[i];
+    }
     delete explosion_particle;
     delete bullet_particle;
 
@@ -130,15 +177,26 @@ Game::~Game()
         delete bullet_templates_[i];
     }
 
+    for (int i = 0; i < enemy_templates_.size(); i++) {
+        delete enemy_templates_[i];
+    }
+
     // Close window
-    glfwDestroyWindow(window_);
-    glfwTerminate();
+    if (window_) {
+        glfwDestroyWindow(window_);
+        glfwTerminate();
+    }
 }
 
 
 void Game::Setup(void)
 {
-    Helper::setSeed();
+    // the render benchmark needs the same world every run
+    if (RENDER_BENCHMARK) {
+        Helper::setSeed(RENDER_BENCHMARK_SEED);
+    } else {
+        Helper::setSeed();
+    }
 
     // Setup the game world
 
@@ -151,26 +209,26 @@ void Game::Setup(void)
     game_objects_.push_back(&enemy_objects_);
     game_objects_.push_back(&collectible_objects_);
     game_objects_.push_back(&background_objects_);
-    game_objects_.push_back(&explosion_objects_);
     game_objects_.push_back(&ui_objects_);
     game_objects_.push_back(&bullet_objects_);
     game_objects_.push_back(&text_objects_);
 
     // Setup the player object (position, texture, vertex count)
-    player_objects_.push_back(new PlayerGameObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, &sprite_shader_, player_body_tex_));
+    player_objects_.push_back(new PlayerGameObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, sprite_shader_, player_body_tex_));
     player = dynamic_cast<PlayerGameObject*>(player_objects_[0]);       // player pointer
     float pi_over_two = glm::pi<float>() / 2.0f;
     player_objects_[0]->SetRotation(pi_over_two);
+    enemy_steering_.setPlayer(player);
 
     // Default turret
-    auto* default_turret = new TurretObject(player, TurretType::NORMAL, glm::vec3(player->GetPosition().x, player->GetPosition().y, 1.0), sprite_, &sprite_shader_, turret_tex_);
+    auto* default_turret = new TurretObject(player, TurretType::NORMAL, glm::vec3(player->GetPosition().x, player->GetPosition().y, 1.0), sprite_, sprite_shader_, turret_tex_);
     default_turret->SetScale(2.0f);
     default_turret->SetFireCooldown(0.3f);
     turret_templates_.push_back(default_turret);
     default_turret->setHealth(100.0f);
 
     // Machine turret
-    auto* machine_turret = new TurretObject(player, TurretType::MACHINE_GUN, glm::vec3(player->GetPosition().x, player->GetPosition().y, 1.0), sprite_, &sprite_shader_, tex_[12]);
+    auto* machine_turret = new TurretObject(player, TurretType::MACHINE_GUN, glm::vec3(player->GetPosition().x, player->GetPosition().y, 1.0), sprite_, sprite_shader_, tex_[12]);
     machine_turret->SetScale(2.0f);
     machine_turret->SetHitbox(0.7f);
     machine_turret->SetFireCooldown(0.1f);
@@ -178,7 +236,7 @@ void Game::Setup(void)
     machine_turret->setHealth(500.0f);
 
     // Cannon
-    auto* cannon = new TurretObject(player, TurretType::CANNON, glm::vec3(player->GetPosition().x, player->GetPosition().y, 1.0), sprite_, &sprite_shader_, tex_[16]);
+    auto* cannon = new TurretObject(player, TurretType::CANNON, glm::vec3(player->GetPosition().x, player->GetPosition().y, 1.0), sprite_, sprite_shader_, tex_[16]);
     cannon->SetScale(2.0f);
     cannon->SetHitbox(0.9f);
     cannon->SetFireCooldown(1.0f);
@@ -186,7 +244,7 @@ void Game::Setup(void)
     turret_templates_.push_back(cannon);
 
     // homing turret
-    auto* homing_turret = new TurretObject(player, TurretType::HOMING, glm::vec3(player->GetPosition().x, player->GetPosition().y, 1.0), sprite_, &sprite_shader_, tex_[26]);
+    auto* homing_turret = new TurretObject(player, TurretType::HOMING, glm::vec3(player->GetPosition().x, player->GetPosition().y, 1.0), sprite_, sprite_shader_, tex_[26]);
     homing_turret->SetScale(2.0f);
     homing_turret->SetHitbox(0.7f);
     homing_turret->SetFireCooldown(0.5f);
@@ -194,41 +252,65 @@ void Game::Setup(void)
     homing_turret->setHealth(1000.0f);
 
     // Setup explosion_particle
-    explosion_particle = new ParticleSystem(glm::vec3(0, 0, 0), explosion_particles_, &particle_shader_, particle_tex_, NULL, EXPLOSION_PARTICLE, 5.0f, 0.7f, 0.0f);
+    explosion_particle = new ParticleSystem(glm::vec3(0, 0, 0), explosion_particles_, explosion_shader_, particle_tex_, NULL, EXPLOSION_PARTICLE, 5.0f, 0.7f, 0.0f);
+    explosions_.Init(explosion_particle, explosion_instanced_shader_);
+    if (gpu_particles_) {
+        gpu_sparks_.Init(particle_feedback_shader_, particle_feedback_render_shader_, particle_tex_);
+    } else {
+        sparks_.Init(particle_stream_shader_, particle_tex_);
+    }
 
     // Setup bullet_particle
-    bullet_particle = new ParticleSystem(glm::vec3(0, 0, 0), bullet_particles_, &particle_shader_, particle_tex_, NULL, BULLET_PARTICLE, 1.0f, 10.0f, 0.0f);
+    bullet_particle = new ParticleSystem(glm::vec3(0, 0, 0), bullet_particles_, bullet_particle_shader_, particle_tex_, NULL, BULLET_PARTICLE, 1.0f, 10.0f, 0.0f);
+
+    // Bullets share one trail renderer instead of copying bullet_particle
+    bullet_trails_.Init(bullet_particle, trail_instanced_shader_);
+    bullet_trails_.setBudget(BulletType::MACHINE_BULLET, MACHINE_BULLET_TRAIL_BUDGET);
 
     // Set up bullets
-    auto* normal_bullet = new BulletObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, &sprite_shader_, bullet_tex_, 30.0f, glm::vec3(0.0f, 1.0f, 0.0f), 20.0f, 2.0f, 0.1f, BulletType::NORMAL);
+    auto* normal_bullet = new BulletObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, sprite_shader_, bullet_tex_, 30.0f, glm::vec3(0.0f, 1.0f, 0.0f), 20.0f, 2.0f, 0.1f, BulletType::NORMAL);
     normal_bullet->setWeight(80.0f);
     normal_bullet->SetScale(10.0);
-    normal_bullet->SetTrail(bullet_particle, 0.2f);
+    normal_bullet->SetTrail(&bullet_trails_, 0.2f);
     bullet_templates_.push_back(normal_bullet);
 
-    auto* machine_bullet = new BulletObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, &sprite_shader_, tex_[13], 30.0f, glm::vec3(0.0f, 1.0f, 0.0f), 25.0f, 2.0f, 0.1f, BulletType::MACHINE_BULLET);
+    auto* machine_bullet = new BulletObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, sprite_shader_, tex_[13], 30.0f, glm::vec3(0.0f, 1.0f, 0.0f), 25.0f, 2.0f, 0.1f, BulletType::MACHINE_BULLET);
     machine_bullet->setWeight(30.0f);
     machine_bullet->SetScale(5.0);
-    machine_bullet->SetTrail(bullet_particle, 0.1f);
+    machine_bullet->SetTrail(&bullet_trails_, 0.1f);
     bullet_templates_.push_back(machine_bullet);
 
-    auto* cannonball = new BulletObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, &sprite_shader_, tex_[17], 100.0f, glm::vec3(0.0f, 1.0f, 0.0f), 10.0f, 2.0f, 0.1f, BulletType::CANNONBALL);
+    auto* cannonball = new BulletObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, sprite_shader_, tex_[17], 100.0f, glm::vec3(0.0f, 1.0f, 0.0f), 10.0f, 2.0f, 0.1f, BulletType::CANNONBALL);
     cannonball->setWeight(200.0f);
     cannonball->SetScale(5.0);
     bullet_templates_.push_back(cannonball);
 
-    auto* bigbullet = new BulletObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, &sprite_shader_, tex_[19], 100.0f, glm::vec3(0.0f, 1.0f, 0.0f), 15.0f, 10.0f, 0.1f, BulletType::BIGBULLET);
+    auto* bigbullet = new BulletObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, sprite_shader_, tex_[19], 100.0f, glm::vec3(0.0f, 1.0f, 0.0f), 15.0f, 10.0f, 0.1f, BulletType::BIGBULLET);
     bigbullet->setWeight(100.0f);
     bigbullet->SetScale(10.0);
-    bigbullet->SetTrail(bullet_particle, 0.8f);
+    bigbullet->SetTrail(&bullet_trails_, 0.8f);
     bullet_templates_.push_back(bigbullet);
 
-    auto* homing_bullet = new BulletObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, &sprite_shader_, tex_[27], 30.0f, glm::vec3(0.0f, 1.0f, 0.0f), 15.0f, 10.0f, 0.1f, BulletType::HOMING);
+    auto* homing_bullet = new BulletObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, sprite_shader_, tex_[27], 30.0f, glm::vec3(0.0f, 1.0f, 0.0f), 15.0f, 10.0f, 0.1f, BulletType::HOMING);
     homing_bullet->setWeight(80.0f);
     homing_bullet->SetScale(5.0);
-    homing_bullet->SetEnemyObjects(&enemy_objects_);
+    homing_bullet->SetEnemyTree(&enemy_tree_);
     bullet_templates_.push_back(homing_bullet);
 
+    // bullet objects are added and expired through the expiry ring
+    bullet_expiry_ring_.setBullets(&bullet_objects_);
+    for (int i = 0; i < bullet_templates_.size(); i++) {
+        bullet_templates_[i]->SetExpiryRing(&bullet_expiry_ring_);
+    }
+
+    // simulate every shot as packed data instead of bullet objects
+    if (USE_PROJECTILE_SYSTEM) {
+        for (int i = 0; i < bullet_templates_.size(); i++) {
+            bullet_templates_[i]->SetProjectiles(&projectiles_);
+        }
+    }
+    projectiles_.setUp(&enemy_objects_, &enemy_tree_, player);
+
 
     default_turret->SetBullet(normal_bullet);
     machine_turret->SetBullet(machine_bullet);
@@ -239,33 +321,54 @@ void Game::Setup(void)
     player->SetTurret(default_turret);
     player->SetDefaultTurret(default_turret);
 
+    // Set up enemy templates, in EnemyType order
+    auto* melee_enemy = new MeleeEnemyObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, sprite_shader_, melee_enemy_tex_, player, arm_tex_, saw_tex_);
+    enemy_templates_.push_back(melee_enemy);
+
+    auto* ranged_enemy = new RangedEnemyObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, sprite_shader_, ranged_enemy_tex_, player, &bullet_objects_);
+    ranged_enemy->setBullets(normal_bullet);
+    enemy_templates_.push_back(ranged_enemy);
+
+    auto* charge_enemy = new ChargeEnemyObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, sprite_shader_, charge_enemy_tex_, player, &bullet_objects_);
+    charge_enemy->setBullets(bigbullet);
+    enemy_templates_.push_back(charge_enemy);
+
+    for (int i = 0; i < enemy_templates_.size(); i++) {
+        enemy_templates_[i]->SetRotation(pi_over_two);
+        enemy_templates_[i]->setSteering(&enemy_steering_);
+        enemy_templates_[i]->setFlowField(&flow_field_);
+    }
+
     // Setup other objects
     if (TEST) {
         // test
-        enemy_objects_.push_back(new MeleeEnemyObject(glm::vec3(2.0f, 0.0f, 0.0f), sprite_, &sprite_shader_, melee_enemy_tex_, player, arm_tex_, saw_tex_));
-        enemy_objects_[0]->SetRotation(pi_over_two);
+        auto* test_enemy = new MeleeEnemyObject(glm::vec3(2.0f, 0.0f, 0.0f), sprite_, sprite_shader_, melee_enemy_tex_, player, arm_tex_, saw_tex_);
+        test_enemy->SetRotation(pi_over_two);
+        test_enemy->setSteering(&enemy_steering_);
+        test_enemy->setFlowField(&flow_field_);
+        enemy_objects_.push_back(test_enemy);
 
         // Setup collectibles
-        auto* four_turrets = new CollectibleGameObject(glm::vec3(5.0f, 5.0f, 0.0f), sprite_, &sprite_shader_, tex_[7], CollectibleType::FOUR_TURRETS);
+        auto* four_turrets = new CollectibleGameObject(glm::vec3(5.0f, 5.0f, 0.0f), sprite_, sprite_shader_, tex_[7], CollectibleType::FOUR_TURRETS);
         collectible_objects_.push_back(four_turrets);
 
-        auto* machine_turret_collectible = new CollectibleGameObject(glm::vec3(-5.0f, -5.0f, 0.0f), sprite_, &sprite_shader_, tex_[14], CollectibleType::MACHINE_GUN);
+        auto* machine_turret_collectible = new CollectibleGameObject(glm::vec3(-5.0f, -5.0f, 0.0f), sprite_, sprite_shader_, tex_[14], CollectibleType::MACHINE_GUN);
         collectible_objects_.push_back(machine_turret_collectible);
 
-        auto* shotgun_collectible = new CollectibleGameObject(glm::vec3(5.0f, -5.0f, 0.0f), sprite_, &sprite_shader_, tex_[15], CollectibleType::SHOTGUN);
+        auto* shotgun_collectible = new CollectibleGameObject(glm::vec3(5.0f, -5.0f, 0.0f), sprite_, sprite_shader_, tex_[15], CollectibleType::SHOTGUN);
         collectible_objects_.push_back(shotgun_collectible);
 
-        auto* cannon_collectible = new CollectibleGameObject(glm::vec3(0.0f, -10.0f, 0.0f), sprite_, &sprite_shader_, tex_[18], CollectibleType::CANNON);
+        auto* cannon_collectible = new CollectibleGameObject(glm::vec3(0.0f, -10.0f, 0.0f), sprite_, sprite_shader_, tex_[18], CollectibleType::CANNON);
         collectible_objects_.push_back(cannon_collectible);
 
-        auto* homing_collectible = new CollectibleGameObject(glm::vec3(0.0f, 10.0f, 0.0f), sprite_, &sprite_shader_, tex_[25], CollectibleType::HOMING);
+        auto* homing_collectible = new CollectibleGameObject(glm::vec3(0.0f, 10.0f, 0.0f), sprite_, sprite_shader_, tex_[25], CollectibleType::HOMING);
         collectible_objects_.push_back(homing_collectible);
 
         // Setup win condition collectibles
-        win_1 = new CollectibleGameObject(glm::vec3(20.0f, 20.0f, 0.0f), sprite_, &sprite_shader_, tex_[8], CollectibleType::WIN_CONDITION);
-        win_2 = new CollectibleGameObject(glm::vec3(-20.0f, -20.0f, 0.0f), sprite_, &sprite_shader_, tex_[9], CollectibleType::WIN_CONDITION);
-        win_3 = new CollectibleGameObject(glm::vec3(20.0f, -20.0f, 0.0f), sprite_, &sprite_shader_, tex_[10], CollectibleType::WIN_CONDITION);
-        win_4 = new CollectibleGameObject(glm::vec3(-20.0f, 20.0f, 0.0f), sprite_, &sprite_shader_, tex_[11], CollectibleType::WIN_CONDITION);
+        win_1 = new CollectibleGameObject(glm::vec3(20.0f, 20.0f, 0.0f), sprite_, sprite_shader_, tex_[8], CollectibleType::WIN_CONDITION);
+        win_2 = new CollectibleGameObject(glm::vec3(-20.0f, -20.0f, 0.0f), sprite_, sprite_shader_, tex_[9], CollectibleType::WIN_CONDITION);
+        win_3 = new CollectibleGameObject(glm::vec3(20.0f, -20.0f, 0.0f), sprite_, sprite_shader_, tex_[10], CollectibleType::WIN_CONDITION);
+        win_4 = new CollectibleGameObject(glm::vec3(-20.0f, 20.0f, 0.0f), sprite_, sprite_shader_, tex_[11], CollectibleType::WIN_CONDITION);
 
         win_1->SetMovement(1.0, 3.5, glm::vec2(win_1->GetPosition().x, win_1->GetPosition().y));
         win_2->SetMovement(1.0, 3.5, glm::vec2(win_2->GetPosition().x, win_2->GetPosition().y));
@@ -282,7 +385,7 @@ void Game::Setup(void)
         collectible_objects_.push_back(win_2);
         collectible_objects_.push_back(win_3);
         collectible_objects_.push_back(win_4);
-        exit_door = new CollectibleGameObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, &sprite_shader_, tex_[29], CollectibleType::WIN_CONDITION);
+        exit_door = new CollectibleGameObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, sprite_shader_, tex_[29], CollectibleType::WIN_CONDITION);
         exit_door->SetScale(5.0f);
     }
     else {
@@ -302,73 +405,73 @@ void Game::Setup(void)
         win_2 = spawnWinningCollectible(tex_[9]);
         win_3 = spawnWinningCollectible(tex_[10]);
         win_4 = spawnWinningCollectible(tex_[11]);
-        exit_door = new CollectibleGameObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, &sprite_shader_, tex_[29], CollectibleType::WIN_CONDITION);
+        exit_door = new CollectibleGameObject(glm::vec3(0.0f, 0.0f, 0.0f), sprite_, sprite_shader_, tex_[29], CollectibleType::WIN_CONDITION);
         exit_door->SetScale(5.0f);
     }
     
     // Setup background
-    GameObject* background = new BackgroundControllerObject(background_sprite_, &sprite_shader_, background_tex_, player);
+    GameObject* background = new BackgroundControllerObject(background_sprite_, sprite_shader_, background_tex_, player);
     background_objects_.push_back(background);
 
     // Setup start & end screens
-    end_screen_lose_ = new GameObject(glm::vec3(0, 0, 0), sprite_, &sprite_shader_, end_screen_lose_tex_);
+    end_screen_lose_ = new GameObject(glm::vec3(0, 0, 0), sprite_, sprite_shader_, end_screen_lose_tex_);
     end_screen_lose_->SetScale(30);
 
-    end_screen_win_ = new GameObject(glm::vec3(0, 0, 0), sprite_, &sprite_shader_, end_screen_win_tex_);
+    end_screen_win_ = new GameObject(glm::vec3(0, 0, 0), sprite_, sprite_shader_, end_screen_win_tex_);
     end_screen_win_->SetScale(30);
 
-    start_screen_ = new GameObject(glm::vec3(0, 0, 0), sprite_, &sprite_shader_, start_screen_tex_);
+    start_screen_ = new GameObject(glm::vec3(0, 0, 0), sprite_, sprite_shader_, start_screen_tex_);
     start_screen_->SetScale(20);
 
     // Setup collision handler
-    collision_handler.setUp(&player_objects_, &enemy_objects_, &bullet_objects_,
+    collision_handler.setUp(&player_objects_, &enemy_objects_, &bullet_objects_, &bullet_expiry_ring_,
                             &collectible_objects_, turret_templates_, &win_1, &win_2, &win_3, &win_4);
 
 
    
 
     // Setup UI
-    UIObject* new_ui = new UIObject(player->GetPosition(), sprite_, &ui_shader_, particle_tex_, player);
-    new_ui->setUp(health_bar_sprite_, arrow_tex_, &sprite_shader_, (GameObject**) & win_1, (GameObject**) & win_2, (GameObject**) & win_3, (GameObject**) & win_4);
+    UIObject* new_ui = new UIObject(player->GetPosition(), sprite_, ui_shader_, particle_tex_, player);
+    new_ui->setUp(health_bar_sprite_, health_bar_shader_, arrow_tex_, ui_shader_, &win_tree_);
     ui_objects_.push_back(new_ui);
 
     // set up text objects
-    auto* health_text = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, &text_shader_, tex_[24]);
+    auto* health_text = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, text_shader_, tex_[24]);
     health_text->SetScale(glm::vec2(12.0/2, 1.0/2));
     health_text->SetOffset(glm::vec2(-8.0f, -8.0f), player);
     text_objects_.push_back(health_text);
 
-    auto* current_weapons_text = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, &text_shader_, tex_[24]);
+    auto* current_weapons_text = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, text_shader_, tex_[24]);
     current_weapons_text->SetScale(glm::vec2(12.0/2, 1.0/2));
     current_weapons_text->SetOffset(glm::vec2(3.5f, -6.5f), player);
     current_weapons_text->SetText("Your current weapons:");
     text_objects_.push_back(current_weapons_text);
 
-    auto* get_to_exit_text = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, &text_shader_, tex_[24]);
+    auto* get_to_exit_text = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, text_shader_, tex_[24]);
     get_to_exit_text->SetScale(glm::vec2(12.0/2, 1.0/2));
     get_to_exit_text->SetOffset(glm::vec2(0.0f, 9.0f), player);
     get_to_exit_text->SetText("Get to the exit!");
     get_to_exit_text->SetVisible(false);
     text_objects_.push_back(get_to_exit_text);
 
-    auto* follow_arrow_text1 = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, &text_shader_, tex_[24]);
+    auto* follow_arrow_text1 = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, text_shader_, tex_[24]);
     follow_arrow_text1->SetScale(glm::vec2(15.0/2, 1.0/2));
     follow_arrow_text1->SetOffset(glm::vec2(0.0f, 8.0f), player);
     follow_arrow_text1->SetText("Follow the arrow and collect the");
     text_objects_.push_back(follow_arrow_text1);
 
-    auto* follow_arrow_text2 = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, &text_shader_, tex_[24]);
+    auto* follow_arrow_text2 = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, text_shader_, tex_[24]);
     follow_arrow_text2->SetScale(glm::vec2(15.0/2, 1.0/2));
     follow_arrow_text2->SetOffset(glm::vec2(0.0f, 7.5f), player);
     follow_arrow_text2->SetText("Tokens of Appreciation!");
     text_objects_.push_back(follow_arrow_text2);
 
-    auto* time_text = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, &text_shader_, tex_[24]);
+    auto* time_text = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, text_shader_, tex_[24]);
     time_text->SetScale(glm::vec2(8.0/2, 1.0/2));
     time_text->SetOffset(glm::vec2(-10.0f, 8.0f), player);
     text_objects_.push_back(time_text);
 
-    auto* finish_text = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, &text_shader_, tex_[24]);
+    auto* finish_text = new TextGameObject(glm::vec3(0.0f, 0.0f, -10.0f), sprite_, text_shader_, tex_[24]);
     finish_text->SetScale(glm::vec2(18.0/2, 1.0));
     finish_text->SetOffset(glm::vec2(0.0f, -4.0f), player);
     finish_text->SetVisible(false);
@@ -392,68 +495,107 @@ void Game::ResizeCallback(GLFWwindow* window, int width, int height)
 }
 
 
-void Game::SetTexture(GLuint w, const char *fname)
+void Game::GetWindowSize(int* width, int* height)
 {
-    // Bind texture buffer
-    glBindTexture(GL_TEXTURE_2D, w);
-
-    // Load texture from a file to the buffer
-    int width, height;
-    unsigned char* image = SOIL_load_image(fname, &width, &height, 0, SOIL_LOAD_RGBA);
-    if (!image){
-        std::cout << "Cannot load texture " << fname << std::endl;
+    if (window_) {
+        glfwGetWindowSize(window_, width, height);
+    } else {
+        *width = window_width_g;
+        *height = window_height_g;
     }
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-    SOIL_free_image_data(image);
+}
+
 
-    // Texture Wrapping
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+void Game::SetTexture(GLuint w, const char *fname, float world_size, bool mipmaps, TextureFormat format, GLenum wrap)
+{
+    if (!USE_COMPACT_TEXTURES) {
+        format = TextureFormat::RGBA8;
+    }
+    if (!USE_TEXTURE_MIPMAPS) {
+        TextureLoader::Load(w, fname, std::numeric_limits<float>::max(), false, format, wrap);
+        return;
+    }
 
-    // Texture Filtering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // Pixels the texture covers at most, a world unit is CAMERA_ZOOM of half the shorter side of the window
+    float screen_size = world_size * CAMERA_ZOOM * texture_window_size_ / 2.0f;
+    TextureLoader::Load(w, fname, screen_size, mipmaps, format, wrap);
 }
 
 
 void Game::SetAllTextures(void)
 {
+    // A texture file, the largest it is drawn at in world units, whether it gets mipmaps, and the format it is stored in
+    // Sprites shrunk to a few dozen pixels keep soft edges in RGBA4, bullets drawn near full size have hard edges for RGB5_A1,
+    // opaque screens and the one sprite with many colours and soft edges are block compressed, and the grey font keeps one channel
+    struct TextureAsset {
+        const char* file;
+        float world_size;
+        bool mipmaps;
+        TextureFormat format;
+    };
+
     // Load all textures that we will need
     // Declare all the textures here
-    const char *texture[] =
-        {"/textures/player.png", "/textures/green_enemy.png", "/textures/blue_enemy.png",
-        "/textures/red_enemy.png", "/textures/orb.png", "/textures/turret.png",
-        "/textures/bullet.png", "/textures/4turret_collectible.png", "/textures/win1.png",
-        "/textures/win2.png", "/textures/win3.png", "/textures/win4.png", "/textures/machine_turret.png",
-        "/textures/machine_bullet.png", "/textures/machine_turret_collectible.png", "/textures/shotgun_collectible.png",
-        "/textures/cannon.png", "/textures/cannonball.png", "/textures/cannon_collectible.png",
-        "/textures/bigbullet.png",  "/textures/losing.png", "/textures/winning.png",
-        "/textures/arrow.png", "/textures/normal_turret_collectible.png", "/textures/font.png",
-        "/textures/homing_turret_collectible.png", "/textures/homing_turret.png", "/textures/homing_bullet.png",
-        "/textures/start_screen.png", "/textures/door.png", "/textures/arm.png",
-        "/textures/saw.png" };
+    const TextureAsset texture[] = {
+        {"/textures/player.png", 1.0f, true, TextureFormat::RGBA4},
+        {"/textures/green_enemy.png", MELEE_ENEMY_SIZE, true, TextureFormat::RGBA4},
+        {"/textures/blue_enemy.png", RANGED_ENEMY_SIZE, true, TextureFormat::RGBA4},
+        {"/textures/red_enemy.png", CHARGE_ENEMY_SIZE, true, TextureFormat::RGBA4},
+        {"/textures/orb.png", 5.0f, true, TextureFormat::RGBA8},
+        {"/textures/turret.png", 2.0f, true, TextureFormat::RGBA4},
+        {"/textures/bullet.png", 10.0f, true, TextureFormat::RGB5_A1},
+        {"/textures/4turret_collectible.png", 2.0f, true, TextureFormat::RGBA4},
+        {"/textures/win1.png", 3.0f, true, TextureFormat::RGBA4},
+        {"/textures/win2.png", 3.0f, true, TextureFormat::RGBA4},
+        {"/textures/win3.png", 3.0f, true, TextureFormat::RGBA4},
+        {"/textures/win4.png", 3.0f, true, TextureFormat::RGBA4},
+        {"/textures/machine_turret.png", 2.0f, true, TextureFormat::RGBA4},
+        {"/textures/machine_bullet.png", 5.0f, true, TextureFormat::RGB5_A1},
+        {"/textures/machine_turret_collectible.png", 2.0f, true, TextureFormat::RGBA4},
+        {"/textures/shotgun_collectible.png", 2.0f, true, TextureFormat::RGBA4},
+        {"/textures/cannon.png", 2.0f, true, TextureFormat::RGBA4},
+        {"/textures/cannonball.png", 5.0f, true, TextureFormat::RGB5_A1},
+        {"/textures/cannon_collectible.png", 2.0f, true, TextureFormat::COMPRESSED_RGBA},
+        {"/textures/bigbullet.png", 10.0f, true, TextureFormat::RGB5_A1},
+        {"/textures/losing.png", 30.0f, true, TextureFormat::COMPRESSED_RGB},
+        {"/textures/winning.png", 30.0f, true, TextureFormat::COMPRESSED_RGB},
+        {"/textures/arrow.png", 4.0f, true, TextureFormat::RGBA4},
+        {"/textures/normal_turret_collectible.png", 2.0f, true, TextureFormat::RGBA4},
+        {"/textures/font.png", 7.0f, false, TextureFormat::LUMINANCE},
+        {"/textures/homing_turret_collectible.png", 2.0f, true, TextureFormat::RGBA4},
+        {"/textures/homing_turret.png", 2.0f, true, TextureFormat::RGBA4},
+        {"/textures/homing_bullet.png", 5.0f, true, TextureFormat::RGB5_A1},
+        {"/textures/start_screen.png", 20.0f, true, TextureFormat::COMPRESSED_RGB},
+        {"/textures/door.png", 5.0f, true, TextureFormat::RGBA4},
+        {"/textures/arm.png", 1.0f, true, TextureFormat::RGB5_A1},
+        {"/textures/saw.png", 2.0f, true, TextureFormat::RGBA4} };
     // Declare background textures
-    const char *background_texture[] = {"/textures/background.png"};
+    const TextureAsset background_texture[] = {{"/textures/background.png", 20.0f, true, TextureFormat::COMPRESSED_RGB}};
     // Get number of declared textures
-    int num_textures = sizeof(texture) / sizeof(char *);
-    int num_background_textures = sizeof(background_texture) / sizeof(char*);
+    int num_textures = sizeof(texture) / sizeof(TextureAsset);
+    int num_background_textures = sizeof(background_texture) / sizeof(TextureAsset);
     // Allocate a buffer for all texture references
     tex_ = new GLuint[num_textures];
     background_tex_ = new GLuint[num_background_textures];
     glGenTextures(num_textures, tex_);
     glGenTextures(num_background_textures, background_tex_);
+    // Sized for the window as it is now, Render loads them again if it grows
+    int width, height;
+    GetWindowSize(&width, &height);
+    texture_window_size_ = std::min(width, height);
     // Load each texture
     for (int i = 0; i < num_textures; i++){
-        SetTexture(tex_[i], (resources_directory_g+std::string(texture[i])).c_str());
+        SetTexture(tex_[i], (resources_directory_g+std::string(texture[i].file)).c_str(), texture[i].world_size, texture[i].mipmaps, texture[i].format);
     }
     // Load background texture
     for (int i = 0; i < num_background_textures; i++){
-        SetTexture(background_tex_[i], (resources_directory_g+std::string(background_texture[i])).c_str());
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+        SetTexture(background_tex_[i], (resources_directory_g+std::string(background_texture[i].file)).c_str(), background_texture[i].world_size, background_texture[i].mipmaps, background_texture[i].format, GL_MIRRORED_REPEAT);
+    }
+    if (REPORT_TEXTURE_MEMORY) {
+        TextureLoader::DumpMemory(std::cout);
     }
     // Set first texture in the array as default
-    glBindTexture(GL_TEXTURE_2D, tex_[0]);
+    GLState::BindTexture(tex_[0]);
 
     // set texture references
     player_body_tex_ = tex_[0];
@@ -482,6 +624,7 @@ void Game::MainLoop(void)
 {
     // Loop while the user did not close the window
     double last_time = glfwGetTime();
+    double last_report_time = last_time;
     while (!glfwWindowShouldClose(window_)){
 
         // Calculate delta time
@@ -512,12 +655,103 @@ void Game::MainLoop(void)
         // Render all the game objects
         Render();
 
+        if (REPORT_GL_STATE && current_time - last_report_time >= 1.0) {
+            std::cout << "GL state calls per frame: " << GLState::getIssued() << " issued, " << GLState::getSkipped() << " skipped" << std::endl;
+            GLStats::Dump(std::cout);
+            last_report_time = current_time;
+        }
+
         // Push buffer drawn in the background onto the display
         glfwSwapBuffers(window_);
     }
 }
 
 
+void Game::RenderBenchmark(int frames)
+{
+    state_ = IN_GAME;
+    glm::vec3 center = player->GetPosition();
+    float golden_angle = glm::pi<float>() * (3.0f - glm::sqrt(5.0f));
+
+    // enemies of every type spread evenly over the screen around the player
+    for (int i = 0; i < RENDER_BENCHMARK_ENEMIES; i++) {
+        float angle = i * golden_angle;
+        float radius = 12.0f * glm::sqrt((i + 0.5f) / RENDER_BENCHMARK_ENEMIES);
+        spawnEnemy(center + glm::vec3(glm::cos(angle), glm::sin(angle), 0.0f) * radius, static_cast<EnemyType>(i % 3));
+    }
+    enemy_tree_.build(enemy_objects_);
+
+    // bullets of every type fanning out of the player
+    for (int i = 0; i < RENDER_BENCHMARK_BULLETS; i++) {
+        float angle = i * golden_angle;
+        glm::vec3 direction(glm::cos(angle), glm::sin(angle), 0.0f);
+        BulletObject* bullet = bullet_templates_[i % bullet_templates_.size()];
+        bullet->Fire(center + direction * (1.0f + (i % 20) * 0.5f), direction, bullet->GetScale(), player, &bullet_objects_);
+    }
+
+    // explosions on some of the enemies, advanced far enough that their particles have spread
+    for (int i = 0; i < RENDER_BENCHMARK_EXPLOSIONS && i < enemy_objects_.size(); i++) {
+        GameObject* enemy = enemy_objects_[(i * 7) % enemy_objects_.size()];
+        spawnExplosion(enemy->GetPosition(), enemy->GetScale());
+    }
+    current_time_ += RENDER_BENCHMARK_SCENE_TIME;
+    bullet_trails_.setTime(current_time_);
+    if (gpu_particles_) {
+        gpu_sparks_.Update(RENDER_BENCHMARK_SCENE_TIME);
+    } else {
+        sparks_.Update(RENDER_BENCHMARK_SCENE_TIME);
+    }
+
+    // a framebuffer object the size of the window, a headless context has nothing else to draw into
+    int width, height;
+    GetWindowSize(&width, &height);
+    GLuint framebuffer, renderbuffers[2];
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glGenRenderbuffers(2, renderbuffers);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[0]);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, renderbuffers[1]);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        throw(std::runtime_error(std::string("Could not create the render benchmark framebuffer")));
+    }
+    glViewport(0, 0, width, height);
+
+    // one frame first, so shader compiles and uploads the driver puts off are not timed
+    Render();
+    glFinish();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        Render();
+    }
+    glFinish();
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // FNV-1a over the last frame's pixels, any change in what is drawn changes it
+    std::vector<unsigned char> pixels(width * height * 4);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    uint64_t checksum = 14695981039346656037ull;
+    for (int i = 0; i < pixels.size(); i++) {
+        checksum = (checksum ^ pixels[i]) * 1099511628211ull;
+    }
+
+    std::cout << "Render benchmark: " << glGetString(GL_RENDERER) << ", " << width << "x" << height << ", "
+              << enemy_objects_.size() << " enemies, " << bullet_objects_.size() + projectiles_.getCount() << " bullets, "
+              << explosions_.getCount() << " explosions" << std::endl;
+    std::cout << "  " << frames << " frames, " << elapsed / frames << " ms/frame, "
+              << GLStats::getDraws() << " draws and " << GLStats::getIndices() << " indices in the last frame" << std::endl;
+    GLStats::Dump(std::cout);
+    std::cout << "  image checksum " << std::hex << std::setw(16) << std::setfill('0') << checksum << std::dec << std::setfill(' ') << std::endl;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteRenderbuffers(2, renderbuffers);
+    glDeleteFramebuffers(1, &framebuffer);
+}
+
 void Game::HandleControlsInGame(double delta_time)
 {
     // Get current position and angle
@@ -609,8 +843,8 @@ void Game::HandleControlsInGame(double delta_time)
     x = x / width;
     y = y / height;
 
-    // call player's TurnTurrets method
-    player->TurnTurrets(glm::vec2(x, y), delta_time);
+    // call player's TurnTurrets method with the cursor in the world, through the view last rendered
+    player->TurnTurrets(view_.Inverse().Apply(glm::vec2(x, y)), delta_time);
 }
 
 
@@ -643,6 +877,7 @@ void Game::Update(double delta_time)
 {
     // Update time
     current_time_ += delta_time;
+    bullet_trails_.setTime(current_time_);
 
     // Update movement input vecotr
     movement_input.x = front_input - back_input;
@@ -655,67 +890,92 @@ void Game::Update(double delta_time)
     }
     case IN_GAME: {
 
+        // enemy occupancy and headings for this frame
+        flow_field_.Update(player->GetPosition(), enemy_objects_);
+
         // Update all game objects
         for (int i = 0; i < game_objects_.size(); i++) {
-            std::vector<GameObject*> current_vector = *game_objects_[i];
+            if (game_objects_[i] == &enemy_objects_) {
+                updateEnemies(delta_time);
+                continue;
+            }
+            // text follows the final positions, so it is updated after collision below
+            if (game_objects_[i] == &text_objects_) {
+                continue;
+            }
+
+            std::vector<GameObject*>& current_vector = *game_objects_[i];
 
             for (int j = 0; j < current_vector.size(); j++) {
                 // Get current game object
                 GameObject* current_game_object = current_vector[j];
 
-                // Update current game object
-                current_game_object->Update(delta_time);
+                // Update current game object, skipping objects with nothing to do
+                if (current_game_object->isActive()) {
+                    current_game_object->Update(delta_time);
+                }
             }
         }
 
+        // apply all enemy steering queued during the updates in one batch
+        enemy_steering_.flush(delta_time);
+
+        projectiles_.Update(delta_time);
+
+        // enemies have moved, refresh their player distances for the despawn sweep and collision
+        enemy_player_cache_.update(enemy_objects_, player->GetPosition());
+
         // remove dead objects
         // Player
         if (player->isDead()) {
             state_ = END_SCREEN_LOSE;
         }
 
-        // Bullets
-        for (int j = 0; j < bullet_objects_.size(); j++) {
-            // dynamic cast to bullet object
-            BulletObject* bullet = dynamic_cast<BulletObject*>(bullet_objects_[j]);
-
-            if (!bullet->IsAlive())
-            {
-                Helper::removeByIndex(&bullet_objects_, j);
-                --j;
-            }
-        }
+        // Bullets whose lifetime ran out
+        bullet_expiry_ring_.Update(delta_time);
 
         // Enemies  
         for (int i = 0; i < enemy_objects_.size(); i++) {
-            GameObject* current_enemy = enemy_objects_[i];
+            EnemyGameObject* current_enemy = static_cast<EnemyGameObject*>(enemy_objects_[i]);
 
             if (current_enemy->isDead()) {
                 // spawn explosion
                 spawnExplosion(current_enemy->GetPosition(), current_enemy->GetScale());
                 // remove enemy
+                projectiles_.forget(current_enemy);
                 Helper::removeByIndex(&enemy_objects_, i);
                 --i;
+                continue;
             }
 
             // too far from player
-            if (glm::length(current_enemy->GetPosition() - player->GetPosition()) >= ENEMY_DESPAWN_RANGE) {
+            if (current_enemy->getPlayerDistance() >= ENEMY_DESPAWN_RANGE) {
                 // remove enemy
+                projectiles_.forget(current_enemy);
                 Helper::removeByIndex(&enemy_objects_, i);
                 --i;
             }
         }
 
-        // Explosion
-        for (int i = 0; i < explosion_objects_.size(); i++) {
-            Explosion* current_explosion = dynamic_cast<Explosion*>(explosion_objects_[i]);
-
-            if (current_explosion->timesUp()) {
-                // remove explosion
-                Helper::removeByIndex(&explosion_objects_, i);
+        // Squads emptied by the removals
+        for (int i = 0; i < squads_.size(); i++) {
+            if (squads_[i]->isEmpty()) {
+                Helper::removeByIndex(&squads_, i);
+                --i;
             }
         }
 
+        // index the surviving enemies for the spawn checks below and next frame's homing bullets
+        enemy_tree_.build(enemy_objects_);
+
+        // Explosions that have finished
+        explosions_.Update(current_time_);
+        if (gpu_particles_) {
+            gpu_sparks_.Update(delta_time);
+        } else {
+            sparks_.Update(delta_time);
+        }
+
         // Spawn enemiesS
 
         // near player
@@ -744,20 +1004,31 @@ void Game::Update(double delta_time)
 
         // handle collision
         collision_handler.Update(delta_time);
+        projectiles_.Collide(delta_time);
 
         // Update timers
         player_enemy_spawn_timer.Update(delta_time);
         
-        if (win_1 != NULL && glm::length(player->GetPosition() - win_1->GetPosition()) <= COLLECIBLE_ENEMY_SPAWN_RANGE) {
+        // collected ones are null and come out infinitely far
+        win_collectibles_.clear();
+        win_collectibles_.push_back(win_1);
+        win_collectibles_.push_back(win_2);
+        win_collectibles_.push_back(win_3);
+        win_collectibles_.push_back(win_4);
+        win_player_cache_.update(win_collectibles_, player->GetPosition());
+        // the arrow's, built after collision so it never holds one collected and deleted this frame
+        win_tree_.build(win_collectibles_);
+
+        if (win_player_cache_.getDistance(0) <= COLLECIBLE_ENEMY_SPAWN_RANGE) {
             collectible_1_enemy_spawn_timer.Update(delta_time);
         }
-        if (win_2 != NULL && glm::length(player->GetPosition() - win_2->GetPosition()) <= COLLECIBLE_ENEMY_SPAWN_RANGE) {
+        if (win_player_cache_.getDistance(1) <= COLLECIBLE_ENEMY_SPAWN_RANGE) {
             collectible_2_enemy_spawn_timer.Update(delta_time);
         }
-        if (win_3 != NULL && glm::length(player->GetPosition() - win_3->GetPosition()) <= COLLECIBLE_ENEMY_SPAWN_RANGE) {
+        if (win_player_cache_.getDistance(2) <= COLLECIBLE_ENEMY_SPAWN_RANGE) {
             collectible_3_enemy_spawn_timer.Update(delta_time);
         }
-        if (win_4 != NULL && glm::length(player->GetPosition() - win_4->GetPosition()) <= COLLECIBLE_ENEMY_SPAWN_RANGE) {
+        if (win_player_cache_.getDistance(3) <= COLLECIBLE_ENEMY_SPAWN_RANGE) {
             collectible_4_enemy_spawn_timer.Update(delta_time);
         }
 
@@ -777,21 +1048,21 @@ void Game::Update(double delta_time)
             CollectibleGameObject* icon;
             switch (current_turret->GetType()) {
                 case TurretType::NORMAL:{
-                    icon = new CollectibleGameObject(glm::vec3(player->GetPosition().x + i*1.8+1.0, player->GetPosition().y - 8.0, 0), sprite_, &sprite_shader_, tex_[23], CollectibleType::FOUR_TURRETS);
+                    icon = new CollectibleGameObject(glm::vec3(player->GetPosition().x + i*1.8+1.0, player->GetPosition().y - 8.0, 0), sprite_, sprite_shader_, tex_[23], CollectibleType::FOUR_TURRETS);
                     break;
                 }
                 case TurretType::MACHINE_GUN:{
-                    icon = new CollectibleGameObject(glm::vec3(player->GetPosition().x + i*1.8+1.0, player->GetPosition().y - 8.0, 0), sprite_, &sprite_shader_, tex_[14], CollectibleType::MACHINE_GUN);
+                    icon = new CollectibleGameObject(glm::vec3(player->GetPosition().x + i*1.8+1.0, player->GetPosition().y - 8.0, 0), sprite_, sprite_shader_, tex_[14], CollectibleType::MACHINE_GUN);
                     break;
                 }
                 case TurretType::CANNON:
                 {
-                    icon = new CollectibleGameObject(glm::vec3(player->GetPosition().x + i*1.8+1.0, player->GetPosition().y - 8.0, 0), sprite_, &sprite_shader_, tex_[18], CollectibleType::CANNON);
+                    icon = new CollectibleGameObject(glm::vec3(player->GetPosition().x + i*1.8+1.0, player->GetPosition().y - 8.0, 0), sprite_, sprite_shader_, tex_[18], CollectibleType::CANNON);
                     break;
                 }
                 case TurretType::HOMING:
                 {
-                    icon = new CollectibleGameObject(glm::vec3(player->GetPosition().x + i*1.8+1.0, player->GetPosition().y - 8.0, 0), sprite_, &sprite_shader_, tex_[25], CollectibleType::HOMING);
+                    icon = new CollectibleGameObject(glm::vec3(player->GetPosition().x + i*1.8+1.0, player->GetPosition().y - 8.0, 0), sprite_, sprite_shader_, tex_[25], CollectibleType::HOMING);
                     break;
                 }
             }
@@ -802,7 +1073,9 @@ void Game::Update(double delta_time)
 
         // update text objects
         for (int i = 0; i < text_objects_.size(); i++) {
-            text_objects_[i]->Update(delta_time);
+            if (text_objects_[i]->isActive()) {
+                text_objects_[i]->Update(delta_time);
+            }
         }
 
         // check health and update UI
@@ -875,9 +1148,18 @@ void Game::Render(void){
                  viewport_background_color_g.b, 0.0);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+    // Start writing this frame's transforms
+    transforms_.BeginFrame();
+
     // Use aspect ratio to properly scale the window
     int width, height;
-    glfwGetWindowSize(window_, &width, &height);
+    GetWindowSize(&width, &height);
+
+    // Textures kept the levels the window they were loaded in needed, a larger one can need more
+    if (USE_TEXTURE_MIPMAPS && std::min(width, height) > texture_window_size_) {
+        TextureLoader::Rescale(static_cast<float>(std::min(width, height)) / texture_window_size_);
+        texture_window_size_ = std::min(width, height);
+    }
     glm::mat4 window_scale_matrix;
     if (width > height){
         float aspect_ratio = ((float) width)/((float) height);
@@ -888,7 +1170,7 @@ void Game::Render(void){
     }
 
     // Set view to zoom out
-    float camera_zoom = 0.10f;
+    float camera_zoom = CAMERA_ZOOM;
     glm::mat4 camera_zoom_matrix = glm::scale(glm::mat4(1.0f), glm::vec3(camera_zoom, camera_zoom, camera_zoom));
     glm::mat4 camera_translate_matrix;
     glm::mat4 view_matrix;
@@ -898,46 +1180,121 @@ void Game::Render(void){
         // set camera at 0, 0, 0
         camera_translate_matrix = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0));
         view_matrix = window_scale_matrix * camera_zoom_matrix * camera_translate_matrix;
+        camera_.Update(view_matrix);
 
-        start_screen_->Render(view_matrix, current_time_);
+        start_screen_->Render(current_time_);
         break;
     }
-    case IN_GAME:
+    case IN_GAME: {
         // set camera as follow player
         camera_translate_matrix = glm::translate(glm::mat4(1.0f), -player->GetPosition());
         view_matrix = window_scale_matrix * camera_zoom_matrix * camera_translate_matrix;
+        camera_.Update(view_matrix);
+        view_ = Transform2D::FromMat4(view_matrix);
 
-        // Render all game objects
+        // Submit every draw of the frame, each group of game objects is a layer drawn in the order it holds its objects
+        render_queue_.clear();
         for (int i = 0; i < game_objects_.size(); i++) {
-            std::vector<GameObject*> current_vector = *game_objects_[i];
+            std::vector<GameObject*>& current_vector = *game_objects_[i];
+            RenderPass pass = (game_objects_[i] == &ui_objects_ || game_objects_[i] == &text_objects_) ? RenderPass::OVERLAY : RenderPass::SCENE;
 
             for (int j = 0; j < current_vector.size(); j++) {
-                current_vector[j]->Render(view_matrix, current_time_);
+                render_queue_.push(RenderQueue::MakeKey(pass, i), current_vector[j]);
             }
-        }
 
+            // projectiles draw with the bullets
+            if (game_objects_[i] == &bullet_objects_) {
+                render_queue_.push(RenderQueue::MakeKey(pass, i), RenderSystem::PROJECTILES);
+            }
+        }
         if (exit_door_opened) {
-            exit_door->Render(view_matrix, current_time_);
+            render_queue_.push(RenderQueue::MakeKey(RenderPass::SCENE, static_cast<int>(game_objects_.size())), exit_door);
+        }
+
+        // every particle after the scene, under the ui; blending is additive, so these are free to go in state order
+        render_queue_.push(RenderQueue::MakeKey(RenderPass::PARTICLES, 0, explosion_instanced_shader_->GetShaderProgram(), particle_tex_, 0), RenderSystem::EXPLOSIONS);
+        render_queue_.push(RenderQueue::MakeKey(RenderPass::PARTICLES, 0, trail_instanced_shader_->GetShaderProgram(), particle_tex_, 0), RenderSystem::TRAILS);
+        Shader* sparks_shader = gpu_particles_ ? particle_feedback_render_shader_ : particle_stream_shader_;
+        render_queue_.push(RenderQueue::MakeKey(RenderPass::PARTICLES, 0, sparks_shader->GetShaderProgram(), particle_tex_, 0), RenderSystem::SPARKS);
+
+        // Draw them in key order, so each pass runs together
+        render_queue_.sort();
+        bool in_particle_pass = false;
+        for (int i = 0; i < render_queue_.getCount(); i++) {
+            const RenderItem& item = render_queue_.getItem(i);
+
+            // the particle pass draws into the reduced resolution target, added over the scene as it ends
+            bool particle_pass = RenderQueue::getPass(item.key) == RenderPass::PARTICLES;
+            if (USE_REDUCED_RESOLUTION_PARTICLES && particle_pass != in_particle_pass) {
+                if (particle_pass) {
+                    particle_target_.Bind();
+                } else {
+                    particle_target_.Unbind();
+                    particle_target_.Composite();
+                }
+            }
+            in_particle_pass = particle_pass;
+
+            if (item.object != nullptr) {
+                item.object->Render(current_time_);
+            } else {
+                RenderBatch(item.system);
+            }
+        }
+        if (USE_REDUCED_RESOLUTION_PARTICLES && in_particle_pass) {
+            particle_target_.Unbind();
+            particle_target_.Composite();
         }
 
         break;
-    
+    }
     case END_SCREEN_LOSE:
         // set camera at 0, 0, 0
         camera_translate_matrix = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0));
         view_matrix = window_scale_matrix * camera_zoom_matrix * camera_translate_matrix;
+        camera_.Update(view_matrix);
 
-        end_screen_lose_->Render(view_matrix, current_time_);
+        end_screen_lose_->Render(current_time_);
         break;
 
     case END_SCREEN_WIN:
         // set camera at 0, 0, 0
         camera_translate_matrix = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0));
         view_matrix = window_scale_matrix * camera_zoom_matrix * camera_translate_matrix;
+        camera_.Update(view_matrix);
+
+        end_screen_win_->Render(current_time_);
+        text_objects_[6]->Render(current_time_);
+
+        break;
+    }
+
+    transforms_.EndFrame();
+    GLState::EndFrame();
+    GLStats::EndFrame();
+}
 
-        end_screen_win_->Render(view_matrix, current_time_);
-        text_objects_[6]->Render(view_matrix, current_time_);
 
+void Game::RenderBatch(RenderSystem system)
+{
+    switch (system) {
+    case RenderSystem::PROJECTILES:
+        projectiles_.Render(current_time_);
+        break;
+    case RenderSystem::EXPLOSIONS:
+        explosions_.Render(current_time_);
+        break;
+    case RenderSystem::SPARKS:
+        if (gpu_particles_) {
+            gpu_sparks_.Render();
+        } else {
+            sparks_.Render();
+        }
+        break;
+    case RenderSystem::TRAILS:
+        bullet_trails_.Render(current_time_);
+        break;
+    default:
         break;
     }
 }
@@ -945,33 +1302,121 @@ void Game::Render(void){
 
 // Object Spawner
 void Game::spawnExplosion(glm::vec3 position, float scale) {
-    GameObject* new_explosion = new Explosion(position, explosion_particle->getGeometry(), explosion_particle->getShader(), explosion_particle->getTexture(), explosion_particle->getType(), explosion_particle->getCycle(), explosion_particle->getSpeed(), explosion_particle->getGravity(), scale);
-    explosion_objects_.push_back(new_explosion);
+    explosions_.spawn(position, scale, current_time_);
+
+    // sparks thrown out of the explosion, slowing down as they fade
+    ParticleEmitter sparks;
+    sparks.position = position;
+    sparks.min_speed = 2.0f * scale;
+    sparks.max_speed = 6.0f * scale;
+    sparks.lifetime = 0.8f;
+    sparks.size = 0.1f * scale;
+    sparks.drag = 2.0f;
+    if (gpu_particles_) {
+        gpu_sparks_.burst(sparks, EXPLOSION_SPARK_COUNT);
+    } else {
+        sparks_.burst(sparks, EXPLOSION_SPARK_COUNT);
+    }
 }
 
 
 void Game::spawnEnemy(glm::vec3 position, EnemyType enemy_type) {
-    float pi_over_two = glm::pi<float>() / 2.0f;
-    GameObject* new_enemy;
+    // copy the template, which already has its properties, children, bullets and steering set up
+    // moved with its arms and saw, which collide before the first update places them
+    EnemyGameObject* new_enemy = enemy_templates_[static_cast<int>(enemy_type)]->clone();
+    new_enemy->Translate(position - new_enemy->GetPosition());
+    new_enemy->setTargetPosition(position);
+    addToSquad(new_enemy);
+    enemy_objects_.push_back(new_enemy);
+}
 
-    switch (enemy_type) {
-    case EnemyType::MELEE_ENEMY:
-        new_enemy = new MeleeEnemyObject(position, sprite_, &sprite_shader_, melee_enemy_tex_, player, arm_tex_, saw_tex_);
-        break;
 
-    case EnemyType::RANGED_ENEMY:
-        new_enemy = new RangedEnemyObject(position, sprite_, &sprite_shader_, ranged_enemy_tex_, player, &bullet_objects_);
-        dynamic_cast<RangedEnemyObject*>(new_enemy)->setBullets(bullet_templates_[0]);
-        break;
+void Game::updateEnemies(double delta_time) {
+    melee_enemies_.clear();
+    ranged_enemies_.clear();
+    charge_enemies_.clear();
 
-    case EnemyType::CHARGE_ENEMY:
-        new_enemy = new ChargeEnemyObject(position, sprite_, &sprite_shader_, charge_enemy_tex_, player, &bullet_objects_);
-        dynamic_cast<ChargeEnemyObject*>(new_enemy)->setBullets(bullet_templates_[3]);
-        break;
+    // player distances and directions for this tick in one pass, after the player has moved
+    enemy_player_cache_.update(enemy_objects_, player->GetPosition());
+
+    for (int i = 0; i < enemy_objects_.size(); i++) {
+        EnemyGameObject* current_enemy = static_cast<EnemyGameObject*>(enemy_objects_[i]);
+        current_enemy->setPlayerCache(&enemy_player_cache_, i);
+
+        switch (current_enemy->getType()) {
+        case EnemyType::MELEE_ENEMY:
+            melee_enemies_.push_back(static_cast<MeleeEnemyObject*>(current_enemy));
+            break;
+
+        case EnemyType::RANGED_ENEMY:
+            ranged_enemies_.push_back(static_cast<RangedEnemyObject*>(current_enemy));
+            break;
+
+        case EnemyType::CHARGE_ENEMY:
+            charge_enemies_.push_back(static_cast<ChargeEnemyObject*>(current_enemy));
+            break;
+        }
     }
 
-    new_enemy->SetRotation(pi_over_two);
-    enemy_objects_.push_back(new_enemy);
+    for (int i = 0; i < melee_enemies_.size(); i++) {
+        melee_enemies_[i]->Update(delta_time);
+    }
+    for (int i = 0; i < ranged_enemies_.size(); i++) {
+        ranged_enemies_[i]->Update(delta_time);
+    }
+    for (int i = 0; i < charge_enemies_.size(); i++) {
+        charge_enemies_[i]->Update(delta_time);
+    }
+}
+
+
+void Game::addToSquad(EnemyGameObject* enemy) {
+    EnemySquad* nearest_squad = nullptr;
+    float nearest_distance = SQUAD_JOIN_RANGE;
+
+    for (int i = 0; i < squads_.size(); i++) {
+        EnemySquad* current_squad = squads_[i];
+        EnemyGameObject* leader = current_squad->getLeader();
+
+        // only squads still running as a group can take new members
+        if (current_squad->isFull() || leader->getState() == EnemyState::ENGAGE || leader->getState() == EnemyState::CHARGE) {
+            continue;
+        }
+
+        float distance_to_leader = glm::length(enemy->GetPosition() - leader->GetPosition());
+        if (distance_to_leader <= nearest_distance) {
+            nearest_squad = current_squad;
+            nearest_distance = distance_to_leader;
+        }
+    }
+
+    if (nearest_squad != nullptr) {
+        nearest_squad->add(enemy);
+    }
+    else {
+        squads_.push_back(new EnemySquad(enemy));
+    }
+}
+
+
+bool Game::overlapsEnemy(glm::vec3 position, float hitbox) {
+    // candidates within reach of the largest enemy hitbox, then the exact check
+    enemy_tree_.withinRadius(position, hitbox + MAX_ENEMY_SIZE / 2, &nearby_enemies_);
+    for (int i = 0; i < nearby_enemies_.size(); i++) {
+        GameObject* current_enemy = nearby_enemies_[i];
+        if (glm::length(position - current_enemy->GetPosition()) < hitbox + current_enemy->getHitbox()) {
+            return true;
+        }
+    }
+
+    // enemies spawned since the tree was built
+    for (int i = enemy_tree_.getCount(); i < enemy_objects_.size(); i++) {
+        GameObject* current_enemy = enemy_objects_[i];
+        if (glm::length(position - current_enemy->GetPosition()) < hitbox + current_enemy->getHitbox()) {
+            return true;
+        }
+    }
+    return false;
 }
 
 
@@ -1006,14 +1451,8 @@ void Game::spawnEnemyNearPlayer() {
             glm::vec3 new_position = Helper::generate2dPosition(player->GetPosition(), MIN_SPAWNABLE_DISTANCE_FROM_PLAYER, MAX_SPAWNABLE_DISTANCE_FROM_PLAYER);
 
             // check for collisions with other enemies
-            for (int j = 0; j < enemy_objects_.size(); j++) {
-                GameObject* current_enemy = enemy_objects_[j];
-                float distance_to_enemy = glm::length(new_position - current_enemy->GetPosition());
-                if (distance_to_enemy < (new_enemy_hitbox + current_enemy->getHitbox())) {
-                    // collides with enemy
-                    collides = true;
-                    break;
-                }
+            if (overlapsEnemy(new_position, new_enemy_hitbox)) {
+                collides = true;
             }
 
             if (!collides) {    // no collision 
@@ -1073,14 +1512,8 @@ void Game::spawnEnemyNearCollectible() {
 
 
                     // check for collisions with other enemies
-                    for (int j = 0; j < enemy_objects_.size(); j++) {
-                        GameObject* current_enemy = enemy_objects_[j];
-                        float distance_to_enemy = glm::length(new_position - current_enemy->GetPosition());
-                        if (distance_to_enemy < (new_enemy_hitbox + current_enemy->getHitbox())) {
-                            // collides with enemy
-                            collides = true;
-                            break;
-                        }
+                    if (overlapsEnemy(new_position, new_enemy_hitbox)) {
+                        collides = true;
                     }
 
                     if (!collides) {    // no collision 
@@ -1138,14 +1571,8 @@ void Game::spawnEnemyNearCollectible() {
 
 
                     // check for collisions with other enemies
-                    for (int j = 0; j < enemy_objects_.size(); j++) {
-                        GameObject* current_enemy = enemy_objects_[j];
-                        float distance_to_enemy = glm::length(new_position - current_enemy->GetPosition());
-                        if (distance_to_enemy < (new_enemy_hitbox + current_enemy->getHitbox())) {
-                            // collides with enemy
-                            collides = true;
-                            break;
-                        }
+                    if (overlapsEnemy(new_position, new_enemy_hitbox)) {
+                        collides = true;
                     }
 
                     if (!collides) {    // no collision 
@@ -1203,14 +1630,8 @@ void Game::spawnEnemyNearCollectible() {
 
 
                     // check for collisions with other enemies
-                    for (int j = 0; j < enemy_objects_.size(); j++) {
-                        GameObject* current_enemy = enemy_objects_[j];
-                        float distance_to_enemy = glm::length(new_position - current_enemy->GetPosition());
-                        if (distance_to_enemy < (new_enemy_hitbox + current_enemy->getHitbox())) {
-                            // collides with enemy
-                            collides = true;
-                            break;
-                        }
+                    if (overlapsEnemy(new_position, new_enemy_hitbox)) {
+                        collides = true;
                     }
 
                     if (!collides) {    // no collision 
@@ -1268,14 +1689,8 @@ void Game::spawnEnemyNearCollectible() {
 
 
                     // check for collisions with other enemies
-                    for (int j = 0; j < enemy_objects_.size(); j++) {
-                        GameObject* current_enemy = enemy_objects_[j];
-                        float distance_to_enemy = glm::length(new_position - current_enemy->GetPosition());
-                        if (distance_to_enemy < (new_enemy_hitbox + current_enemy->getHitbox())) {
-                            // collides with enemy
-                            collides = true;
-                            break;
-                        }
+                    if (overlapsEnemy(new_position, new_enemy_hitbox)) {
+                        collides = true;
                     }
 
                     if (!collides) {    // no collision 
@@ -1300,26 +1715,26 @@ void Game::spawnCollectible() {
     // checks which type to spawn
     if (spawn_type < FOUR_TURRETS_SPAWN_WEIGHT) {
         // spawns four turret
-        auto* four_turrets = new CollectibleGameObject(spawn_position, sprite_, &sprite_shader_, tex_[7], CollectibleType::FOUR_TURRETS);
+        auto* four_turrets = new CollectibleGameObject(spawn_position, sprite_, sprite_shader_, tex_[7], CollectibleType::FOUR_TURRETS);
         collectible_objects_.push_back(four_turrets);
     }
     else if (spawn_type < MACHINE_GUN_SPAWN_WEIGHT + FOUR_TURRETS_SPAWN_WEIGHT) {
         // spawns machine gun
-        auto* machine_turret_collectible = new CollectibleGameObject(spawn_position, sprite_, &sprite_shader_, tex_[14], CollectibleType::MACHINE_GUN);
+        auto* machine_turret_collectible = new CollectibleGameObject(spawn_position, sprite_, sprite_shader_, tex_[14], CollectibleType::MACHINE_GUN);
         collectible_objects_.push_back(machine_turret_collectible);
     }
     else if (spawn_type < SHOTGUN_SPAWN_WEIGHT + MACHINE_GUN_SPAWN_WEIGHT + FOUR_TURRETS_SPAWN_WEIGHT) {
         // spawns shotgun
-        auto* shotgun_collectible = new CollectibleGameObject(spawn_position, sprite_, &sprite_shader_, tex_[15], CollectibleType::SHOTGUN);
+        auto* shotgun_collectible = new CollectibleGameObject(spawn_position, sprite_, sprite_shader_, tex_[15], CollectibleType::SHOTGUN);
         collectible_objects_.push_back(shotgun_collectible);
     }
     else if (spawn_type < CANNON_SPAWN_WEIGHT + SHOTGUN_SPAWN_WEIGHT + MACHINE_GUN_SPAWN_WEIGHT + FOUR_TURRETS_SPAWN_WEIGHT) {
         // spawns cannon
-        auto* cannon_collectible = new CollectibleGameObject(spawn_position, sprite_, &sprite_shader_, tex_[18], CollectibleType::CANNON);
+        auto* cannon_collectible = new CollectibleGameObject(spawn_position, sprite_, sprite_shader_, tex_[18], CollectibleType::CANNON);
         collectible_objects_.push_back(cannon_collectible);
     } else {
         // spawns homing
-        auto* homing_turret_collectible = new CollectibleGameObject(spawn_position, sprite_, &sprite_shader_, tex_[25], CollectibleType::HOMING);
+        auto* homing_turret_collectible = new CollectibleGameObject(spawn_position, sprite_, sprite_shader_, tex_[25], CollectibleType::HOMING);
         collectible_objects_.push_back(homing_turret_collectible);
     }
 }
@@ -1327,7 +1742,7 @@ void Game::spawnCollectible() {
 
 CollectibleGameObject* Game::spawnWinningCollectible(GLuint texture) {
     glm::vec3 spawn_position = Helper::generate2dPosition(player->GetPosition(), player->getHitbox() * 4, MAX_WIN_COLLECTIBLE_SPAWN_RANGE);
-    auto* win_collectible = new CollectibleGameObject(spawn_position, sprite_, &sprite_shader_, texture, CollectibleType::WIN_CONDITION);
+    auto* win_collectible = new CollectibleGameObject(spawn_position, sprite_, sprite_shader_, texture, CollectibleType::WIN_CONDITION);
     win_collectible->SetMovement(1.0, 3.5, glm::vec2(win_collectible->GetPosition().x, win_collectible->GetPosition().y));
     win_collectible->SetScale(3.0f);
     // add to collectible objects
@@ -9,25 +9,41 @@
 
 #include "background_controller_object.h"
 #include "background_sprite.h"
+#include "bullet_expiry_ring.h"
 #include "bullet_object.h"
+#include "camera_buffer.h"
 #include "charge_enemy_object.h"
 #include "collision_handler.h"
-#include "explosion.h"
+#include "explosion_pool.h"
+#include "feedback_particle_system.h"
+#include "flow_field.h"
 #include "enemy_game_object.h"
+#include "enemy_squad.h"
+#include "enemy_steering.h"
 #include "collectible_game_object.h"
 #include "game_object.h"
+#include "headless_context.h"
 #include "health_bar_sprite.h"
 #include "helper.h"
+#include "kd_tree.h"
 #include "melee_enemy_object.h"
 #include "ranged_enemy_object.h"
 #include "particles.h"
+#include "particle_simulator.h"
 #include "particle_system.h"
+#include "particle_target.h"
 #include "player_game_object.h"
+#include "player_relative_cache.h"
+#include "projectile_system.h"
+#include "render_queue.h"
+#include "shader_cache.h"
 #include "turret_object.h"
 #include "shader.h"
 #include "sprite.h"
 #include "ui_object.h"
 #include "text_game_object.h"
+#include "trail_renderer.h"
+#include "transform_stream.h"
 
 namespace game {
 
@@ -40,8 +56,8 @@ namespace game {
             ~Game();
 
             // Call Init() before calling any other method
-            // Initialize graphics libraries and main window
-            void Init(void); 
+            // Initialize graphics libraries and main window, or a context with no window when headless
+            void Init(bool headless = false); 
 
             // Set up the game (scene, game objects, etc.)
             void Setup(void);
@@ -49,9 +65,16 @@ namespace game {
             // Run the game (keep the game active)
             void MainLoop(void); 
 
+            // Add a fixed set of objects to the game world, then draw it frames times into a framebuffer object
+            // Prints the time per frame, the GL calls of the last frame and a checksum of its image
+            void RenderBenchmark(int frames);
+
         private:
-            // Main window: pointer to the GLFW window structure
-            GLFWwindow *window_;
+            // Main window: pointer to the GLFW window structure, null when headless
+            GLFWwindow *window_ = nullptr;
+
+            // Context without a window, declared before anything holding GL objects so it is released last
+            HeadlessContext headless_context_;
 
             // Sprite geometry
             Geometry *sprite_;
@@ -70,17 +93,45 @@ namespace game {
             // Health bar geometry
             Geometry* health_bar_sprite_;
 
+            // View matrix shared by every shader, uploaded once per frame
+            CameraBuffer camera_;
+
+            // View of the last frame rendered in game, the cursor is brought into the world through it
+            Transform2D view_;
+
+            // Per-instance transforms of the instanced batches
+            TransformStream transforms_;
+
+            // Owns every shader below, each variant is built once and picked as objects are set up
+            ShaderCache shaders_;
+
             // Shader for rendering sprites in the scene
-            Shader sprite_shader_;
+            Shader* sprite_shader_ = nullptr;
+
+            // Shaders for rendering explosion and bullet particles
+            Shader* explosion_shader_ = nullptr;
+            Shader* bullet_particle_shader_ = nullptr;
 
-            // Shader for rendering particles
-            Shader particle_shader_;
+            // Shaders for rendering many explosions, or bullet trails, in one draw
+            Shader* explosion_instanced_shader_ = nullptr;
+            Shader* trail_instanced_shader_ = nullptr;
 
-            // Shader for rendering ui
-            Shader ui_shader_;
+            // Shader for rendering sparks simulated on the cpu
+            Shader* particle_stream_shader_ = nullptr;
+
+            // Shaders advancing and rendering sparks kept in GL buffers
+            Shader* particle_feedback_shader_ = nullptr;
+            Shader* particle_feedback_render_shader_ = nullptr;
+
+            // Shader adding the reduced resolution particles over the scene
+            Shader* particle_composite_shader_ = nullptr;
+
+            // Shaders for rendering ui, textured or as the health bar
+            Shader* ui_shader_ = nullptr;
+            Shader* health_bar_shader_ = nullptr;
 
             // shader for text
-            Shader text_shader_;
+            Shader* text_shader_ = nullptr;
 
 
             // Textures
@@ -88,6 +139,9 @@ namespace game {
             // main
             GLuint* tex_;
 
+            // Shorter side of the largest window so far, the textures keep the levels it needs
+            int texture_window_size_ = 0;
+
             // Groups
             // Player
             GLuint player_body_tex_;
@@ -148,6 +202,27 @@ namespace game {
             // Enemies
             std::vector <GameObject*> enemy_objects_;
 
+            // Enemies split by type each frame, so their updates call the final classes directly
+            std::vector <MeleeEnemyObject*> melee_enemies_;
+            std::vector <RangedEnemyObject*> ranged_enemies_;
+            std::vector <ChargeEnemyObject*> charge_enemies_;
+
+            // Distance and direction from each enemy to the player, indexed like enemy_objects_ at the start of the tick
+            PlayerRelativeCache enemy_player_cache_;
+
+            // Enemy positions indexed once per frame after removals, for homing and spawn checks
+            KdTree enemy_tree_;
+            std::vector <GameObject*> nearby_enemies_;
+
+            // Batched enemy turn, move and aim math
+            EnemySteering enemy_steering_;
+
+            // Shared headings towards the player for engaged enemies
+            FlowField flow_field_;
+
+            // Enemy squads, deleted once empty
+            std::vector <EnemySquad*> squads_;
+
             // Background
             std::vector <GameObject*> background_objects_;
 
@@ -161,16 +236,39 @@ namespace game {
             // Bullet templates
             std::vector <BulletObject*> bullet_templates_;
 
+            // Enemy templates, one per EnemyType, cloned on spawn
+            std::vector <EnemyGameObject*> enemy_templates_;
+
             // Current bullets
             std::vector <GameObject*> bullet_objects_;
 
+            // Removes bullets in the order they expire
+            BulletExpiryRing bullet_expiry_ring_;
+
+            // Bullets as packed data, used instead of bullet_objects_ with USE_PROJECTILE_SYSTEM
+            ProjectileSystem projectiles_;
+
             // Explosion effects
-            std::vector <GameObject*> explosion_objects_;
-            ParticleSystem* explosion_particle; // for deep copy
+            ExplosionPool explosions_;
+            ParticleSystem* explosion_particle; // shared by every explosion
+
+            // Sparks thrown by explosions, simulated on the cpu, or on the gpu with USE_GPU_PARTICLES where OpenGL 3.3 is available
+            ParticleSimulator sparks_;
+            FeedbackParticleSystem gpu_sparks_;
+            bool gpu_particles_ = false;
+
+            // Offscreen target for particles with USE_REDUCED_RESOLUTION_PARTICLES
+            ParticleTarget particle_target_;
+
+            // The frame's draws, sorted to keep passes, programs and textures together
+            RenderQueue render_queue_;
 
             // Bullet particles
             ParticleSystem* bullet_particle;    // for deep copy
 
+            // Draws every bullet trail in one instanced call
+            TrailRenderer bullet_trails_;
+
             // Collectibles
             std::vector <GameObject*> collectible_objects_;
 
@@ -192,6 +290,11 @@ namespace game {
             CollectibleGameObject* exit_door;
             bool exit_door_opened = false;
 
+            // Player distance to each win collectible and an index over them, refreshed once per frame
+            std::vector <GameObject*> win_collectibles_;
+            PlayerRelativeCache win_player_cache_;
+            KdTree win_tree_;
+
             // Keep track of time
             double current_time_;
 
@@ -208,8 +311,12 @@ namespace game {
             // Callback for when the window is resized
             static void ResizeCallback(GLFWwindow* window, int width, int height);
 
-            // Set a specific texture
-            void SetTexture(GLuint w, const char *fname);
+            // Size the frame is drawn at, the window's or the default window size when headless
+            void GetWindowSize(int* width, int* height);
+
+            // Set a specific texture, world_size is the largest it is drawn at in world units
+            // mipmaps is false for atlases, whose lookups jump between cells
+            void SetTexture(GLuint w, const char *fname, float world_size, bool mipmaps = true, TextureFormat format = TextureFormat::RGBA8, GLenum wrap = GL_CLAMP_TO_EDGE);
 
             // Load all textures
             void SetAllTextures();
@@ -225,9 +332,18 @@ namespace game {
             // Render the game world
             void Render(void);
 
+            // Draws one of the batched systems submitted to the render queue
+            void RenderBatch(RenderSystem system);
+
             // Object Spawner
             void spawnExplosion(glm::vec3 position, float scale);
             void spawnEnemy(glm::vec3 position, EnemyType enemy_type);
+            // updates enemy_objects_ through the per-type arrays
+            void updateEnemies(double delta_time);
+            // joins the nearest open squad, or leads a new one
+            void addToSquad(EnemyGameObject* enemy);
+            // whether a hitbox at position would overlap an existing enemy
+            bool overlapsEnemy(glm::vec3 position, float hitbox);
             void spawnEnemyNearPlayer();
             void spawnEnemyNearCollectible();
 
@@ -3,6 +3,8 @@
 #include <iostream>
 
 #include "game_object.h"
+#include "gl_state.h"
+#include "gl_stats.h"
 
 namespace game {
 
@@ -58,15 +60,20 @@ void GameObject::SetRotation(float angle){
 
 
 void GameObject::Update(double delta_time) {
-    // move object with knockback
-    SetPosition(GetPosition() + knockback_velocity * static_cast<float>(delta_time));
-
-
-    // knockback velocity decelerate
-    float kb_velocity_length = glm::length(knockback_velocity);
-    if (kb_velocity_length > 0.0f) {
-        glm::vec3 kb_direction = glm::normalize(knockback_velocity);
-        knockback_velocity -= kb_direction * min(knockback_deceleration * static_cast<float>(delta_time), kb_velocity_length);
+    if (knockback_velocity != glm::vec3(0.0f)) {
+        // move object with knockback
+        SetPosition(GetPosition() + knockback_velocity * static_cast<float>(delta_time));
+
+        // knockback velocity decelerate
+        float kb_velocity_length = glm::length(knockback_velocity);
+        glm::vec3 kb_direction = knockback_velocity / kb_velocity_length;
+        float kb_decrease = knockback_deceleration * static_cast<float>(delta_time);
+        if (kb_decrease >= kb_velocity_length) {
+            knockback_velocity = glm::vec3(0.0f);   // stop exactly, so the object can go inactive
+        }
+        else {
+            knockback_velocity -= kb_direction * kb_decrease;
+        }
     }
 
     // Update all child objects
@@ -76,41 +83,31 @@ void GameObject::Update(double delta_time) {
 }
 
 
-void GameObject::Render(glm::mat4 view_matrix, double current_time){
+void GameObject::Render(double current_time){
+    GL_STATS_SCOPE("GameObject::Render");
 
     // Set up the shader
     shader_->Enable();
 
-    // Set up the view matrix
-    shader_->SetUniformMat4("view_matrix", view_matrix);
-
-    // Setup the scaling matrix for the shader
-    glm::mat4 scaling_matrix = glm::scale(glm::mat4(1.0f), glm::vec3(scale_.x, scale_.y, 1.0));
-
-    // Setup the rotation matrix for the shader
-    glm::mat4 rotation_matrix = glm::rotate(glm::mat4(1.0f), angle_, glm::vec3(0.0, 0.0, 1.0));
-
-    // Set up the translation matrix for the shader
-    glm::mat4 translation_matrix = glm::translate(glm::mat4(1.0f), position_);
 
-    // Setup the transformation matrix for the shader
-    glm::mat4 transformation_matrix = translation_matrix * rotation_matrix * scaling_matrix;
+    // Setup the transformation for the shader, scaled, then rotated, then translated
+    Transform2D transformation = Transform2D::Make(position_, angle_, scale_);
 
-    // Set the transformation matrix in the shader
-    shader_->SetUniformMat4("transformation_matrix", transformation_matrix);
+    // Set the transformation in the shader
+    shader_->SetTransform(transformation);
 
     // Set up the geometry
     geometry_->SetGeometry(shader_->GetShaderProgram());
 
     // Bind the entity's texture
-    glBindTexture(GL_TEXTURE_2D, texture_);
+    GLState::BindTexture(texture_);
 
     // Draw the entity
-    glDrawElements(GL_TRIANGLES, geometry_->GetSize(), GL_UNSIGNED_INT, 0);
+    GLStats::DrawElements(GL_TRIANGLES, geometry_->GetSize(), GL_UNSIGNED_INT, 0);
 
     // Render all child objects
     for (auto child : child_objects_) {
-        child->Render(view_matrix, current_time);
+        child->Render(current_time);
     }
 }
 
@@ -121,17 +118,31 @@ void GameObject::Render(glm::mat4 view_matrix, double current_time){
     }
 
 
+    void GameObject::Translate(const glm::vec3& offset)
+    {
+        SetPosition(position_ + offset);
+        for (auto child : child_objects_) {
+            child->Translate(offset);
+        }
+    }
+
+
     void GameObject::knockback(GameObject* knockback_object, float multiplier) {
-        float total_weight = getWeight() + knockback_object->getWeight();
-        glm::vec3 unnormalized_direction = GetPosition() - knockback_object->GetPosition();
+        knockback(knockback_object->GetPosition(), knockback_object->getWeight(), multiplier);
+    }
+
+
+    void GameObject::knockback(glm::vec3 source_position, float source_weight, float multiplier) {
+        float total_weight = getWeight() + source_weight;
+        glm::vec3 unnormalized_direction = GetPosition() - source_position;
         glm::vec3 knockback_direction;
         if (glm::length(unnormalized_direction) != 0.0f) {
-            knockback_direction = glm::normalize(GetPosition() - knockback_object->GetPosition());
+            knockback_direction = glm::normalize(unnormalized_direction);
         }
         else {
             knockback_direction = glm::vec3(0.0f, 0.0f, 0.0f);
         }
-        knockback_velocity += knockback_direction * knockback_force * (knockback_object->getWeight() / total_weight) * multiplier;
+        knockback_velocity += knockback_direction * knockback_force * (source_weight / total_weight) * multiplier;
     }
 
 } // namespace game
@@ -12,6 +12,7 @@
 
 #include "shader.h"
 #include "geometry.h"
+#include "transform2d.h"
 
 namespace game {
 
@@ -32,7 +33,7 @@ namespace game {
             virtual void Update(double delta_time);
 
             // Renders the GameObject 
-            virtual void Render(glm::mat4 view_matrix, double current_time);
+            virtual void Render(double current_time);
 
             // Getters
             inline glm::vec3 GetPosition(void) const { return position_; }
@@ -69,15 +70,18 @@ namespace game {
             // Add child objects to the game object
             void AddChildObject(GameObject* object);
 
+            // Moves the object and its child objects by offset, so they keep their places relative to each other
+            void Translate(const glm::vec3& offset);
+
             // Knockback
             void knockback(GameObject* knockback_object, float multiplier);
+            void knockback(glm::vec3 source_position, float source_weight, float multiplier);
 
             // Helpers
             virtual bool isPlayer() { return false; };
             virtual bool isTurret() { return false; };
             virtual bool isEnemy() { return false; };
             virtual bool isBullet() { return false; };
-            virtual bool isExplosion() { return false; };
             virtual bool isUI() { return false; };
             virtual bool isArm() { return false; };
             virtual bool isSaw() { return false; };
@@ -85,6 +89,9 @@ namespace game {
 
             bool isDead() const { return health <= 0.0f; };
 
+            // Whether Update has anything to do this frame, objects that are not active are skipped
+            inline bool isActive() const { return needs_update || knockback_velocity != glm::vec3(0.0f); };
+
 
         protected:
             // Object's Transform Variables
@@ -119,6 +126,9 @@ namespace game {
             float knockback_deceleration = 10.0f;
             glm::vec3 knockback_velocity = glm::vec3(0.0f, 0.0f, 0.0f);
 
+            // false for objects whose Update only applies knockback
+            bool needs_update = true;
+
     }; // class GameObject
 
 } // namespace game
@@ -0,0 +1,184 @@
+#include "gl_state.h"
+#include "gl_stats.h"
+
+namespace game {
+
+    // No GL name or enum has this value, so it stands for not known
+    static const GLuint UNKNOWN = 0xFFFFFFFF;
+
+    GLuint GLState::program_ = UNKNOWN;
+    GLuint GLState::texture_ = UNKNOWN;
+    GLuint GLState::buffers_[3] = { UNKNOWN, UNKNOWN, UNKNOWN };
+    GLuint GLState::depth_test_ = UNKNOWN;
+    GLuint GLState::depth_func_ = UNKNOWN;
+    GLuint GLState::blend_ = UNKNOWN;
+    GLuint GLState::blend_func_[2] = { UNKNOWN, UNKNOWN };
+
+    int GLState::issued_ = 0;
+    int GLState::skipped_ = 0;
+    int GLState::last_issued_ = 0;
+    int GLState::last_skipped_ = 0;
+
+
+    bool GLState::Changes(GLuint* current, GLuint value)
+    {
+        if (*current == value) {
+            skipped_++;
+            return false;
+        }
+        *current = value;
+        issued_++;
+        return true;
+    }
+
+
+    int GLState::BufferSlot(GLenum target)
+    {
+        switch (target) {
+        case GL_ARRAY_BUFFER:
+            return 0;
+        case GL_ELEMENT_ARRAY_BUFFER:
+            return 1;
+        case GL_UNIFORM_BUFFER:
+            return 2;
+        default:
+            return -1;
+        }
+    }
+
+
+    void GLState::UseProgram(GLuint program)
+    {
+        if (Changes(&program_, program)) {
+            GLStats::CountProgramSwitch();
+            glUseProgram(program);
+        }
+    }
+
+
+    void GLState::BindTexture(GLuint texture)
+    {
+        if (Changes(&texture_, texture)) {
+            GLStats::CountTextureBind();
+            glBindTexture(GL_TEXTURE_2D, texture);
+        }
+    }
+
+
+    void GLState::BindBuffer(GLenum target, GLuint buffer)
+    {
+        int slot = BufferSlot(target);
+        if (slot < 0) {
+            GLStats::CountBufferBind();
+            glBindBuffer(target, buffer);
+            return;
+        }
+        if (Changes(&buffers_[slot], buffer)) {
+            GLStats::CountBufferBind();
+            glBindBuffer(target, buffer);
+        }
+    }
+
+
+    void GLState::SetDepthTest(bool enabled)
+    {
+        if (Changes(&depth_test_, enabled)) {
+            if (enabled) {
+                glEnable(GL_DEPTH_TEST);
+            } else {
+                glDisable(GL_DEPTH_TEST);
+            }
+        }
+    }
+
+
+    void GLState::SetDepthFunc(GLenum func)
+    {
+        if (Changes(&depth_func_, func)) {
+            glDepthFunc(func);
+        }
+    }
+
+
+    void GLState::SetBlend(bool enabled)
+    {
+        if (Changes(&blend_, enabled)) {
+            if (enabled) {
+                glEnable(GL_BLEND);
+            } else {
+                glDisable(GL_BLEND);
+            }
+        }
+    }
+
+
+    void GLState::SetBlendFunc(GLenum source, GLenum destination)
+    {
+        if (blend_func_[0] == source && blend_func_[1] == destination) {
+            skipped_++;
+            return;
+        }
+        blend_func_[0] = source;
+        blend_func_[1] = destination;
+        issued_++;
+        glBlendFunc(source, destination);
+    }
+
+
+    void GLState::DeleteProgram(GLuint program)
+    {
+        if (program_ == program) {
+            program_ = UNKNOWN;
+        }
+        glDeleteProgram(program);
+    }
+
+
+    void GLState::DeleteTextures(GLsizei count, const GLuint* textures)
+    {
+        for (int i = 0; i < count; i++) {
+            if (texture_ == textures[i]) {
+                texture_ = UNKNOWN;
+            }
+        }
+        glDeleteTextures(count, textures);
+    }
+
+
+    void GLState::DeleteBuffers(GLsizei count, const GLuint* buffers)
+    {
+        for (int i = 0; i < count; i++) {
+            for (int slot = 0; slot < 3; slot++) {
+                if (buffers_[slot] == buffers[i]) {
+                    buffers_[slot] = UNKNOWN;
+                }
+            }
+        }
+        glDeleteBuffers(count, buffers);
+    }
+
+
+    void GLState::Invalidate(void)
+    {
+        program_ = UNKNOWN;
+        texture_ = UNKNOWN;
+        for (int slot = 0; slot < 3; slot++) {
+            buffers_[slot] = UNKNOWN;
+        }
+        depth_test_ = UNKNOWN;
+        depth_func_ = UNKNOWN;
+        blend_ = UNKNOWN;
+        blend_func_[0] = UNKNOWN;
+        blend_func_[1] = UNKNOWN;
+    }
+
+
+    void GLState::EndFrame(void)
+    {
+        last_issued_ = issued_;
+        last_skipped_ = skipped_;
+        issued_ = 0;
+        skipped_ = 0;
+    }
+
+} // namespace game
@@ -0,0 +1,68 @@
+#ifndef GL_STATE_H_
+#define GL_STATE_H_
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+namespace game {
+
+    /*
+        GLState shadows the GL state set around every draw: the program, the 2D texture, the array, element and uniform
+        buffers, blending and depth testing
+        A call setting the value that is already current is dropped instead of reaching the driver
+        The shadow is only right while every change to that state goes through here, so objects are deleted through here too,
+        and Invalidate forgets everything after code that bypassed it
+        Only texture unit 0 is tracked, the only one the game uses
+    */
+    class GLState {
+
+    public:
+        static void UseProgram(GLuint program);
+        static void BindTexture(GLuint texture);
+        static void BindBuffer(GLenum target, GLuint buffer);
+
+        static void SetDepthTest(bool enabled);
+        static void SetDepthFunc(GLenum func);
+        static void SetBlend(bool enabled);
+        static void SetBlendFunc(GLenum source, GLenum destination);
+
+        // Deleting an object unbinds it, and its name can be handed out again
+        static void DeleteProgram(GLuint program);
+        static void DeleteTextures(GLsizei count, const GLuint* textures);
+        static void DeleteBuffers(GLsizei count, const GLuint* buffers);
+
+        // Forgets every value, so the next call of each kind reaches the driver
+        static void Invalidate(void);
+
+        // Closes the frame's counts
+        static void EndFrame(void);
+
+        // Calls of the last complete frame that reached the driver, and that were dropped
+        inline static int getIssued(void) { return last_issued_; };
+        inline static int getSkipped(void) { return last_skipped_; };
+
+    private:
+        // Counts the call, returning whether it has to reach the driver
+        static bool Changes(GLuint* current, GLuint value);
+
+        // Index of a tracked buffer target, or -1
+        static int BufferSlot(GLenum target);
+
+        static GLuint program_;
+        static GLuint texture_;
+        static GLuint buffers_[3];      // array, element array, uniform
+        static GLuint depth_test_;
+        static GLuint depth_func_;
+        static GLuint blend_;
+        static GLuint blend_func_[2];
+
+        static int issued_;
+        static int skipped_;
+        static int last_issued_;
+        static int last_skipped_;
+
+    }; // class GLState
+
+} // namespace game
+
+#endif // GL_STATE_H_
@@ -0,0 +1,86 @@
+#include <cstring>
+#include <iomanip>
+
+#include "gl_stats.h"
+
+namespace game {
+
+    std::vector<const char*> GLStats::names_ = { "other" };
+    std::vector<GLCounts> GLStats::counts_ = { GLCounts() };
+    std::vector<GLCounts> GLStats::last_counts_ = { GLCounts() };
+    int GLStats::source_ = 0;
+    int GLStats::draws_ = 0;
+    int GLStats::indices_ = 0;
+    int GLStats::last_draws_ = 0;
+    int GLStats::last_indices_ = 0;
+
+
+    int GLStats::FindSource(const char* name)
+    {
+        for (int i = 0; i < names_.size(); i++) {
+            if (names_[i] == name || std::strcmp(names_[i], name) == 0) {
+                return i;
+            }
+        }
+        names_.push_back(name);
+        counts_.push_back(GLCounts());
+        last_counts_.push_back(GLCounts());
+        return static_cast<int>(names_.size()) - 1;
+    }
+
+
+    void GLStats::EndFrame(void)
+    {
+        last_draws_ = draws_;
+        last_indices_ = indices_;
+        draws_ = 0;
+        indices_ = 0;
+
+        last_counts_.swap(counts_);
+        for (int i = 0; i < counts_.size(); i++) {
+            counts_[i] = GLCounts();
+        }
+    }
+
+
+    GLCounts GLStats::getTotal(void)
+    {
+        GLCounts total;
+        for (int i = 0; i < last_counts_.size(); i++) {
+            total.draws += last_counts_[i].draws;
+            total.indices += last_counts_[i].indices;
+            total.uniforms += last_counts_[i].uniforms;
+            total.texture_binds += last_counts_[i].texture_binds;
+            total.buffer_binds += last_counts_[i].buffer_binds;
+            total.program_switches += last_counts_[i].program_switches;
+        }
+        return total;
+    }
+
+
+    void GLStats::Dump(std::ostream& out)
+    {
+        if (!USE_GL_STATS) {
+            out << "  GL calls by source are not counted, set USE_GL_STATS in config.h" << std::endl;
+            return;
+        }
+
+        auto row = [&out](const char* name, const GLCounts& counts) {
+            out << "  " << std::left << std::setw(32) << name << std::right
+                << std::setw(8) << counts.draws << std::setw(10) << counts.indices << std::setw(10) << counts.uniforms
+                << std::setw(10) << counts.texture_binds << std::setw(10) << counts.buffer_binds << std::setw(10) << counts.program_switches << std::endl;
+        };
+
+        out << "  " << std::left << std::setw(32) << "GL calls last frame" << std::right
+            << std::setw(8) << "draws" << std::setw(10) << "indices" << std::setw(10) << "uniforms"
+            << std::setw(10) << "textures" << std::setw(10) << "buffers" << std::setw(10) << "programs" << std::endl;
+        for (int i = 0; i < last_counts_.size(); i++) {
+            const GLCounts& counts = last_counts_[i];
+            if (counts.draws + counts.uniforms + counts.texture_binds + counts.buffer_binds + counts.program_switches > 0) {
+                row(names_[i], counts);
+            }
+        }
+        row("total", getTotal());
+    }
+
+} // namespace game
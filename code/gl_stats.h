@@ -0,0 +1,116 @@
+#ifndef GL_STATS_H_
+#define GL_STATS_H_
+
+#include <ostream>
+#include <vector>
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+#include "config.h"
+
+namespace game {
+
+    // GL calls of one kind or another made by one source in a frame
+    struct GLCounts {
+        int draws = 0;
+        int indices = 0;            // indices or vertices submitted, times the instance count
+        int uniforms = 0;           // uniform uploads, including per-object transforms and the camera block
+        int texture_binds = 0;
+        int buffer_binds = 0;
+        int program_switches = 0;
+    };
+
+    /*
+        GLStats counts the GL calls of each frame by kind, split by the code that made them
+        A scope opened with GL_STATS_SCOPE names that code, "TurretObject::Render" for instance, until it closes;
+        calls outside any scope go to "other"
+        Binds and program switches are counted by GLState as they reach the driver, draws go through the wrappers here
+        The counts of the last complete frame can be queried or dumped as a table
+        Without USE_GL_STATS the scopes and counts compile to nothing, only the frame's total draws and indices are kept
+    */
+    class GLStats {
+
+    public:
+        // Attributes the calls made while it is open to a source from FindSource, see GL_STATS_SCOPE
+        class Scope {
+        public:
+            inline Scope(int source) { previous_ = source_; source_ = source; };
+            inline ~Scope() { source_ = previous_; };
+        private:
+            int previous_;
+        };
+
+        // Index of the source called name, which has to outlive the program, like a literal; adds it the first time
+        static int FindSource(const char* name);
+
+        inline static void DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+        {
+            CountDraw(count);
+            glDrawElements(mode, count, type, indices);
+        };
+        inline static void DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances)
+        {
+            CountDraw(count * instances);
+            glDrawElementsInstanced(mode, count, type, indices, instances);
+        };
+        inline static void DrawArrays(GLenum mode, GLint first, GLsizei count)
+        {
+            CountDraw(count);
+            glDrawArrays(mode, first, count);
+        };
+
+        inline static void CountUniform(void) { if (USE_GL_STATS) counts_[source_].uniforms++; };
+        inline static void CountTextureBind(void) { if (USE_GL_STATS) counts_[source_].texture_binds++; };
+        inline static void CountBufferBind(void) { if (USE_GL_STATS) counts_[source_].buffer_binds++; };
+        inline static void CountProgramSwitch(void) { if (USE_GL_STATS) counts_[source_].program_switches++; };
+
+        // Closes the frame's counts
+        static void EndFrame(void);
+
+        // Last complete frame, by source and in total
+        inline static int getSourceCount(void) { return static_cast<int>(names_.size()); };
+        inline static const char* getSourceName(int source) { return names_[source]; };
+        inline static const GLCounts& getCounts(int source) { return last_counts_[source]; };
+        static GLCounts getTotal(void);
+        // Draws and indices of the last complete frame, counted with or without USE_GL_STATS
+        inline static int getDraws(void) { return last_draws_; };
+        inline static int getIndices(void) { return last_indices_; };
+
+        // Writes the last complete frame as a table, one row per source that made a call
+        static void Dump(std::ostream& out);
+
+    private:
+        inline static void CountDraw(int indices)
+        {
+            draws_++;
+            indices_ += indices;
+            if (USE_GL_STATS) {
+                counts_[source_].draws++;
+                counts_[source_].indices += indices;
+            }
+        };
+
+        static std::vector<const char*> names_;
+        static std::vector<GLCounts> counts_;
+        static std::vector<GLCounts> last_counts_;
+        static int source_;
+        static int draws_;
+        static int indices_;
+        static int last_draws_;
+        static int last_indices_;
+
+    }; // class GLStats
+
+} // namespace game
+
+// Opens a GLStats scope called name until the end of the enclosing block
+// The source is looked up once per call site and kept in a static
+#if USE_GL_STATS
+#define GL_STATS_SCOPE(name) \
+    static const int gl_stats_source = game::GLStats::FindSource(name); \
+    game::GLStats::Scope gl_stats_scope(gl_stats_source)
+#else
+#define GL_STATS_SCOPE(name)
+#endif
+
+#endif // GL_STATS_H_
@@ -0,0 +1,101 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "headless_context.h"
+
+#ifdef USE_EGL
+#include <EGL/eglext.h>
+#endif
+
+namespace game {
+
+    HeadlessContext::HeadlessContext(void) {}
+
+
+    HeadlessContext::~HeadlessContext()
+    {
+#ifdef USE_EGL
+        if (display_ != EGL_NO_DISPLAY) {
+            eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            if (context_ != EGL_NO_CONTEXT) {
+                eglDestroyContext(display_, context_);
+            }
+            if (surface_ != EGL_NO_SURFACE) {
+                eglDestroySurface(display_, surface_);
+            }
+            eglTerminate(display_);
+        }
+#endif
+    }
+
+
+#ifdef USE_EGL
+    // Whether name is one of the space separated extensions
+    static bool HasExtension(const char* extensions, const char* name)
+    {
+        if (extensions == nullptr) {
+            return false;
+        }
+        size_t length = std::strlen(name);
+        for (const char* start = std::strstr(extensions, name); start != nullptr; start = std::strstr(start + length, name)) {
+            bool starts = start == extensions || start[-1] == ' ';
+            bool ends = start[length] == ' ' || start[length] == '\0';
+            if (starts && ends) {
+                return true;
+            }
+        }
+        return false;
+    }
+#endif
+
+
+    void HeadlessContext::Init(void)
+    {
+#ifdef USE_EGL
+        // a surfaceless display needs no window system at all, otherwise take the default one
+        const char* client_extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if (HasExtension(client_extensions, "EGL_MESA_platform_surfaceless")) {
+            auto get_platform_display = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+            if (get_platform_display != nullptr) {
+                display_ = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+            }
+        }
+        if (display_ == EGL_NO_DISPLAY) {
+            display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        }
+        EGLint major, minor;
+        if (display_ == EGL_NO_DISPLAY || !eglInitialize(display_, &major, &minor)) {
+            display_ = EGL_NO_DISPLAY;
+            throw(std::runtime_error(std::string("Could not initialize an EGL display")));
+        }
+
+        // desktop OpenGL, like the window's context
+        if (!eglBindAPI(EGL_OPENGL_API)) {
+            throw(std::runtime_error(std::string("EGL display does not support OpenGL")));
+        }
+        const EGLint config_attributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_NONE };
+        EGLConfig config;
+        EGLint config_count = 0;
+        if (!eglChooseConfig(display_, config_attributes, &config, 1, &config_count) || config_count == 0) {
+            throw(std::runtime_error(std::string("No EGL config for an OpenGL context")));
+        }
+        context_ = eglCreateContext(display_, config, EGL_NO_CONTEXT, NULL);
+        if (context_ == EGL_NO_CONTEXT) {
+            throw(std::runtime_error(std::string("Could not create an EGL context")));
+        }
+
+        // current without a surface where supported, with a one pixel pbuffer otherwise
+        if (!HasExtension(eglQueryString(display_, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context")) {
+            const EGLint pbuffer_attributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+            surface_ = eglCreatePbufferSurface(display_, config, pbuffer_attributes);
+        }
+        if (!eglMakeCurrent(display_, surface_, surface_, context_)) {
+            throw(std::runtime_error(std::string("Could not make the EGL context current")));
+        }
+#else
+        throw(std::runtime_error(std::string("Headless rendering needs a build with USE_EGL")));
+#endif
+    }
+
+} // namespace game
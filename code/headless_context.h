@@ -0,0 +1,36 @@
+#ifndef HEADLESS_CONTEXT_H_
+#define HEADLESS_CONTEXT_H_
+
+#ifdef USE_EGL
+#include <EGL/egl.h>
+#endif
+
+namespace game {
+
+    /*
+        HeadlessContext makes an OpenGL context current without a window, through EGL on a surfaceless display,
+        so the game can render on machines with no display or GPU, with Mesa's software rasterizer for instance
+        There is no default framebuffer, whatever is drawn has to go to a framebuffer object
+        Only built with USE_EGL, otherwise Init throws
+    */
+    class HeadlessContext {
+
+    public:
+        HeadlessContext(void);
+        ~HeadlessContext();
+
+        // Creates the context and makes it current, throws if that fails
+        void Init(void);
+
+    private:
+#ifdef USE_EGL
+        EGLDisplay display_ = EGL_NO_DISPLAY;
+        EGLContext context_ = EGL_NO_CONTEXT;
+        EGLSurface surface_ = EGL_NO_SURFACE;
+#endif
+
+    }; // class HeadlessContext
+
+} // namespace game
+
+#endif // HEADLESS_CONTEXT_H_
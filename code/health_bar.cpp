@@ -1,4 +1,6 @@
 #include "health_bar.h"
+#include "gl_state.h"
+#include "gl_stats.h"
 
 namespace game {
 
@@ -10,30 +12,18 @@ namespace game {
 	
 	HealthBar::~HealthBar(){};
 
-	void HealthBar::Render(glm::mat4 view_matrix, double current_time) {
+	void HealthBar::Render(double current_time) {
+        GL_STATS_SCOPE("HealthBar::Render");
+
         // Set up the shader
         shader_->Enable();
 
-        // Set up the view matrix
-        shader_->SetUniformMat4("view_matrix", view_matrix);
-
-        // Setup the scaling matrix for the shader
-        glm::mat4 scaling_matrix = glm::scale(glm::mat4(1.0f), glm::vec3(scale_.x, scale_.y, 1.0));
-
-        // Setup the rotation matrix for the shader
-        glm::mat4 rotation_matrix = glm::rotate(glm::mat4(1.0f), angle_, glm::vec3(0.0, 0.0, 1.0));
-
-        // Set up the translation matrix for the shader
-        glm::mat4 translation_matrix = glm::translate(glm::mat4(1.0f), position_);
-
-        // Setup the transformation matrix for the shader
-        glm::mat4 transformation_matrix = translation_matrix * rotation_matrix * scaling_matrix;
 
-        // Set the transformation matrix in the shader
-        shader_->SetUniformMat4("transformation_matrix", transformation_matrix);
+        // Setup the transformation for the shader, scaled, then rotated, then translated
+        Transform2D transformation = Transform2D::Make(position_, angle_, scale_);
 
-        // Set the object type
-        shader_->SetUniform1i("object_type", HEALTH_BAR);
+        // Set the transformation in the shader
+        shader_->SetTransform(transformation);
 
         // Set the health variable
         shader_->SetUniform1f("health", player->getHealth() / player->getMaxHealth());
@@ -42,10 +32,10 @@ namespace game {
         geometry_->SetGeometry(shader_->GetShaderProgram());
 
         // Bind the entity's texture
-        glBindTexture(GL_TEXTURE_2D, texture_);
+        GLState::BindTexture(texture_);
 
         // Draw the entity
-        glDrawElements(GL_TRIANGLES, geometry_->GetSize(), GL_UNSIGNED_INT, 0);
+        GLStats::DrawElements(GL_TRIANGLES, geometry_->GetSize(), GL_UNSIGNED_INT, 0);
 
     }
 
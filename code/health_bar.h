@@ -13,7 +13,7 @@ namespace game {
 		HealthBar(const glm::vec3& position, Geometry* geom, Shader* shader, GLuint texture, GameObject* player);
 		~HealthBar();
 
-		void Render(glm::mat4 view_matrix, double current_time) override;
+		void Render(double current_time) override;
 
 		// Getters
 		inline glm::vec3 getModelPosition() { return model_position; };
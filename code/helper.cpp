@@ -3,40 +3,25 @@
 namespace game {
 
 	float Helper::angleBetweenVectors(glm::vec3 a, glm::vec3 b) {
-		float angleA = std::atan2(a.y, a.x);
-		float angleB = std::atan2(b.y, b.x);
+		// one atan2 of the cross and dot products, already in [-pi, pi]
+		float cross = a.x * b.y - a.y * b.x;
+		float dot = a.x * b.x + a.y * b.y;
 
-		float difference = angleB - angleA;
-
-		difference = normalizeAngle(difference);
-
-		return difference;
+		return std::atan2(cross, dot);
 	}
 
 	
 	float Helper::normalizeAngle(float angle) {
-		// normalize
+		// normalize to (-pi, pi] without looping
 		float pi = glm::pi<float>();
-		while (angle <= pi) {
-			angle += 2 * pi;
-		}
-		while (angle > pi) {
-			angle -= 2 * pi;
-		}
-		return angle;
+		return angle - 2 * pi * std::ceil((angle - pi) / (2 * pi));
 	}
 
 
 	float Helper::normalizeAngleToPositive(float angle) {
-		// normalize
+		// normalize to (0, 2pi] without looping
 		float pi = glm::pi<float>();
-		while (angle <= 0) {
-			angle += 2 * pi;
-		}
-		while (angle > (2 * pi)) {
-			angle -= 2 * pi;
-		}
-		return angle;
+		return angle - 2 * pi * (std::ceil(angle / (2 * pi)) - 1);
 	}
 
 
@@ -44,6 +29,10 @@ namespace game {
 		std::srand(static_cast<unsigned>(std::time(nullptr)));
 	}
 
+	void Helper::setSeed(unsigned seed) {
+		std::srand(seed);
+	}
+
 	glm::vec3 Helper::generate2dPosition(float xLower, float xUpper, float yLower, float yUpper) {
 		// use default_random_engine as generator
 		default_random_engine generator(rand());
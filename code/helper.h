@@ -29,6 +29,8 @@ namespace game {
 
 		// Random
 		static void setSeed();
+		// a fixed seed, so the same calls give the same numbers every run
+		static void setSeed(unsigned seed);
 		static glm::vec3 generate2dPosition(float xLowerbound, float xUpperbound, float yLowerbound, float yUpperbound);
 		static glm::vec3 generate2dPosition(glm::vec3 start_position, float min_range, float max_range);
 		static float generateFloat(float lowerbound, float upperbound);
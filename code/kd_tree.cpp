@@ -0,0 +1,160 @@
+#include <algorithm>
+
+#include "kd_tree.h"
+#include "game_object.h"
+
+namespace game {
+
+	KdTree::KdTree() {}
+
+
+	void KdTree::build(const std::vector<GameObject*>& objects) {
+		nodes_.clear();
+		for (int i = 0; i < objects.size(); i++) {
+			if (objects[i] != nullptr) {
+				glm::vec3 position = objects[i]->GetPosition();
+				nodes_.push_back({ position.x, position.y, objects[i] });
+			}
+		}
+		build(0, static_cast<int>(nodes_.size()), 0);
+	}
+
+
+	void KdTree::build(int begin, int end, int depth) {
+		if (end - begin <= 1) {
+			return;
+		}
+		int middle = (begin + end) / 2;
+		if (depth % 2 == 0) {
+			std::nth_element(nodes_.begin() + begin, nodes_.begin() + middle, nodes_.begin() + end,
+				[](const Node& a, const Node& b) { return a.x < b.x; });
+		}
+		else {
+			std::nth_element(nodes_.begin() + begin, nodes_.begin() + middle, nodes_.begin() + end,
+				[](const Node& a, const Node& b) { return a.y < b.y; });
+		}
+		build(begin, middle, depth + 1);
+		build(middle + 1, end, depth + 1);
+	}
+
+
+	GameObject* KdTree::nearest(glm::vec3 point, float max_distance) const {
+		int best = -1;
+		float best_distance_squared = max_distance < std::numeric_limits<float>::max() ? max_distance * max_distance : max_distance;
+		nearest(0, static_cast<int>(nodes_.size()), 0, point.x, point.y, &best, &best_distance_squared);
+		return best >= 0 ? nodes_[best].object : nullptr;
+	}
+
+
+	void KdTree::nearest(int begin, int end, int depth, float x, float y, int* best, float* best_distance_squared) const {
+		if (begin >= end) {
+			return;
+		}
+		int middle = (begin + end) / 2;
+		const Node& node = nodes_[middle];
+
+		float dx = node.x - x;
+		float dy = node.y - y;
+		float distance_squared = dx * dx + dy * dy;
+		if (distance_squared < *best_distance_squared) {
+			*best_distance_squared = distance_squared;
+			*best = middle;
+		}
+
+		// search the side of the split holding the point first, the other only if it can be closer
+		float split_distance = depth % 2 == 0 ? x - node.x : y - node.y;
+		if (split_distance < 0.0f) {
+			nearest(begin, middle, depth + 1, x, y, best, best_distance_squared);
+			if (split_distance * split_distance < *best_distance_squared) {
+				nearest(middle + 1, end, depth + 1, x, y, best, best_distance_squared);
+			}
+		}
+		else {
+			nearest(middle + 1, end, depth + 1, x, y, best, best_distance_squared);
+			if (split_distance * split_distance < *best_distance_squared) {
+				nearest(begin, middle, depth + 1, x, y, best, best_distance_squared);
+			}
+		}
+	}
+
+
+	void KdTree::nearest(glm::vec3 point, int k, std::vector<GameObject*>* out) const {
+		out->clear();
+		if (k <= 0) {
+			return;
+		}
+
+		// max heap on distance, holding the k closest so far
+		std::vector<std::pair<float, int>> heap;
+		heap.reserve(k);
+		nearest(0, static_cast<int>(nodes_.size()), 0, point.x, point.y, k, &heap);
+
+		std::sort_heap(heap.begin(), heap.end());
+		for (int i = 0; i < heap.size(); i++) {
+			out->push_back(nodes_[heap[i].second].object);
+		}
+	}
+
+
+	void KdTree::nearest(int begin, int end, int depth, float x, float y, int k, std::vector<std::pair<float, int>>* heap) const {
+		if (begin >= end) {
+			return;
+		}
+		int middle = (begin + end) / 2;
+		const Node& node = nodes_[middle];
+
+		float dx = node.x - x;
+		float dy = node.y - y;
+		float distance_squared = dx * dx + dy * dy;
+		if (heap->size() < k) {
+			heap->push_back(std::make_pair(distance_squared, middle));
+			std::push_heap(heap->begin(), heap->end());
+		}
+		else if (distance_squared < heap->front().first) {
+			std::pop_heap(heap->begin(), heap->end());
+			heap->back() = std::make_pair(distance_squared, middle);
+			std::push_heap(heap->begin(), heap->end());
+		}
+
+		float split_distance = depth % 2 == 0 ? x - node.x : y - node.y;
+		int near_begin = split_distance < 0.0f ? begin : middle + 1;
+		int near_end = split_distance < 0.0f ? middle : end;
+		int far_begin = split_distance < 0.0f ? middle + 1 : begin;
+		int far_end = split_distance < 0.0f ? end : middle;
+
+		nearest(near_begin, near_end, depth + 1, x, y, k, heap);
+		if (heap->size() < k || split_distance * split_distance < heap->front().first) {
+			nearest(far_begin, far_end, depth + 1, x, y, k, heap);
+		}
+	}
+
+
+	void KdTree::withinRadius(glm::vec3 point, float radius, std::vector<GameObject*>* out) const {
+		out->clear();
+		withinRadius(0, static_cast<int>(nodes_.size()), 0, point.x, point.y, radius * radius, out);
+	}
+
+
+	void KdTree::withinRadius(int begin, int end, int depth, float x, float y, float radius_squared, std::vector<GameObject*>* out) const {
+		if (begin >= end) {
+			return;
+		}
+		int middle = (begin + end) / 2;
+		const Node& node = nodes_[middle];
+
+		float dx = node.x - x;
+		float dy = node.y - y;
+		if (dx * dx + dy * dy <= radius_squared) {
+			out->push_back(node.object);
+		}
+
+		float split_distance = depth % 2 == 0 ? x - node.x : y - node.y;
+		if (split_distance <= 0.0f || split_distance * split_distance <= radius_squared) {
+			withinRadius(begin, middle, depth + 1, x, y, radius_squared, out);
+		}
+		if (split_distance >= 0.0f || split_distance * split_distance <= radius_squared) {
+			withinRadius(middle + 1, end, depth + 1, x, y, radius_squared, out);
+		}
+	}
+
+} // namespace game
@@ -0,0 +1,53 @@
+#ifndef KD_TREE_H_
+#define KD_TREE_H_
+
+#include <limits>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace game {
+
+	class GameObject;
+
+	/*
+		KdTree is a static 2d index over object positions, rebuilt whenever the objects have moved.
+		It answers nearest, k nearest and radius queries in logarithmic time instead of a linear scan.
+		Positions are copied at build time, the objects must outlive the tree until the next build
+	*/
+	class KdTree {
+
+	public:
+		KdTree();
+
+		// null objects are skipped
+		void build(const std::vector<GameObject*>& objects);
+
+		// closest object within max_distance, nullptr if there is none
+		GameObject* nearest(glm::vec3 point, float max_distance = std::numeric_limits<float>::max()) const;
+		// up to k closest objects, closest first
+		void nearest(glm::vec3 point, int k, std::vector<GameObject*>* out) const;
+		// every object within radius, in no particular order
+		void withinRadius(glm::vec3 point, float radius, std::vector<GameObject*>* out) const;
+
+		inline int getCount() const { return static_cast<int>(nodes_.size()); };
+
+	private:
+		struct Node {
+			float x;
+			float y;
+			GameObject* object;
+		};
+
+		// nodes_[begin, end) is a subtree, split at its middle element on x at even depths and y at odd depths
+		void build(int begin, int end, int depth);
+		void nearest(int begin, int end, int depth, float x, float y, int* best, float* best_distance_squared) const;
+		void nearest(int begin, int end, int depth, float x, float y, int k, std::vector<std::pair<float, int>>* heap) const;
+		void withinRadius(int begin, int end, int depth, float x, float y, float radius_squared, std::vector<GameObject*>* out) const;
+
+		std::vector<Node> nodes_;
+
+	}; // class KdTree
+
+} // namespace game
+
+#endif // KD_TREE_H_
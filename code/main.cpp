@@ -16,6 +16,7 @@
 #include <iostream>
 #include <exception>
 #include "game.h"
+#include "benchmark.h"
 
 // Macro for printing exceptions
 #define PrintException(exception_object)\
@@ -23,15 +24,28 @@
 
 // Main function that builds and runs the game
 int main(void){
+    if (BENCHMARK) {
+        game::Benchmark::RunAll();
+        game::Benchmark::RunOpenGL();
+        return 0;
+    }
+
     game::Game the_game;
 
     try {
-        // Initialize graphics libraries and main window
-        the_game.Init();
-        // Setup the game (game world, game objects, etc.)
-        the_game.Setup();
-        // Run the game
-        the_game.MainLoop();
+        if (RENDER_BENCHMARK) {
+            // Draw a fixed scene offscreen, without a window, and print how it went
+            the_game.Init(true);
+            the_game.Setup();
+            the_game.RenderBenchmark(RENDER_BENCHMARK_FRAMES);
+        } else {
+            // Initialize graphics libraries and main window
+            the_game.Init();
+            // Setup the game (game world, game objects, etc.)
+            the_game.Setup();
+            // Run the game
+            the_game.MainLoop();
+        }
     }
     catch (std::exception &e){
         // Catch and print any errors
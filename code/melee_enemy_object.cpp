@@ -3,30 +3,7 @@
 namespace game {
 
 	MeleeEnemyObject::MeleeEnemyObject(const glm::vec3& position, Geometry* geom, Shader* shader, GLuint texture, PlayerGameObject* player, GLuint arm_texture, GLuint saw_texture)
-		: EnemyGameObject(position, geom, shader, texture, player) {
-		type = EnemyType::MELEE_ENEMY;
-
-		size = MELEE_ENEMY_SIZE;
-		SetScale(size);
-		setHitboxRadius(this->GetScale() / 2);
-		setHealth(MELEE_ENEMY_HEALTH);
-
-		melee_damage = MELEE_ENEMY_MELEE_DAMAGE;
-
-		weight = MELEE_ENEMY_WEIGHT;
-
-		idle_detection_radius = MELEE_ENEMY_IDLE_DETECTION_RADIUS;
-		engage_detection_radius = MELEE_ENEMY_ENGAGE_DETECTION_RADIUS;
-
-		idle_vision_cone = 0.0f;	// in radians. from 0 rad
-		engage_vision_cone = 0.0f;	// in radians, from 0 rad
-
-		speed = MELEE_ENEMY_SPEED;
-		turn_speed = MELEE_ENEMY_TURN_SPEED;	// in radians
-
-		wander_chance = MELEE_ENEMY_WANDER_CHANCE;
-		wander_range = MELEE_ENEMY_WANDER_RANGE;
-
+		: EnemyArchetype(position, geom, shader, texture, player) {
 		// first arm
 		EnemyArmObject* arm = new EnemyArmObject(GetPosition(), getGeometry(), getShader(), arm_texture, false);
 		child_objects_.push_back(arm);
@@ -42,27 +19,39 @@ namespace game {
 		saw_object->setWeight(SAW_WEIGHT);
 		second_arm->addSaw(saw_object);
 		child_objects_.push_back(saw_object);
+
+		arm_object = arm;
+		second_arm_object = second_arm;
+	}
+
+	MeleeEnemyObject::MeleeEnemyObject(const MeleeEnemyObject& other)
+		: EnemyArchetype(other) {
+		// child objects are owned, so copy the arms and saw instead of sharing them
+		arm_object = new EnemyArmObject(*other.arm_object);
+		second_arm_object = new EnemyArmObject(*other.second_arm_object);
+		saw_object = new SawObject(*other.saw_object);
+
+		arm_object->addArm(second_arm_object);
+		second_arm_object->addSaw(saw_object);
+
+		child_objects_.clear();
+		child_objects_.push_back(arm_object);
+		child_objects_.push_back(saw_object);
 	}
 
 	void MeleeEnemyObject::Update(double delta_time) {
 
-		// Update all child objects
-		for (auto child : child_objects_) {
-			if (child->isArm()) {
-				EnemyArmObject* current = dynamic_cast<EnemyArmObject*>(child);
-				current->SetPosition(GetPosition() + current->getModelPosition());
-				current->setTargetPosition(target_position);
-				current->setModelRotation(GetRotation());
-			}
-		}
+		// Update the arm attached to the body
+		arm_object->SetPosition(GetPosition() + arm_object->getModelPosition());
+		arm_object->setTargetPosition(target_position);
+		arm_object->setModelRotation(GetRotation());
 
-		EnemyGameObject::Update(delta_time);
+		updateEnemy(this, delta_time);
 	}
 
 
 	void MeleeEnemyObject::engageAction(double delta_time) {
-		target_position = player_->GetPosition();
-		moveTowardsTarget(delta_time, true);
+		chasePlayer(delta_time);
 	}
 
 
@@ -1,21 +1,21 @@
 #ifndef MELEE_ENEMY_OBJECT_H_
 #define MELEE_ENEMY_OBJECT_H_
 
-#include "enemy_game_object.h"
+#include "enemy_archetype.h"
 #include "enemy_arm_object.h"
 #include "saw_object.h"
 
 namespace game {
 
-	class MeleeEnemyObject : public EnemyGameObject {
+	class MeleeEnemyObject final : public EnemyArchetype<MeleeEnemyObject, EnemyType::MELEE_ENEMY> {
 
 	public:
 		MeleeEnemyObject(const glm::vec3& position, Geometry* geom, Shader* shader, GLuint texture, PlayerGameObject* player, GLuint arm_texture, GLuint saw_texture);
 
-		void Update(double delta_time) override;
+		// deep copy constructor
+		MeleeEnemyObject(const MeleeEnemyObject& other);
 
-		// identify
-		inline bool isMeleeType() override { return true; };
+		void Update(double delta_time) override;
 
 		// engage action
 		void engageAction(double delta_time) override;
@@ -24,6 +24,8 @@ namespace game {
 		inline SawObject* getSaw() { return saw_object; };
 
 	private:
+		EnemyArmObject* arm_object;
+		EnemyArmObject* second_arm_object;
 		SawObject* saw_object;
 
 	}; // class MeleeEnemyObject
@@ -0,0 +1,75 @@
+#include "particle_batch.h"
+#include "gl_state.h"
+#include "gl_stats.h"
+
+namespace game {
+
+    ParticleBatch::ParticleBatch(void) {}
+
+
+    ParticleBatch::~ParticleBatch()
+    {
+        if (instance_vbo_ != 0) {
+            GLState::DeleteBuffers(1, &instance_vbo_);
+        }
+    }
+
+
+    void ParticleBatch::Init(Geometry* particles, Shader* shader, GLuint texture)
+    {
+        particles_ = particles;
+        shader_ = shader;
+        texture_ = texture;
+
+        glGenBuffers(1, &instance_vbo_);
+    }
+
+
+    void ParticleBatch::Render(double current_time)
+    {
+        if (instances_.empty()) {
+            return;
+        }
+
+        // Set up the shader
+        shader_->Enable();
+        shader_->SetUniform1f("current_time", static_cast<float>(current_time));
+
+        // Set up the per-vertex geometry, which also sets blending
+        particles_->SetGeometry(shader_->GetShaderProgram());
+
+        // Upload the instances, reallocating (and orphaning the old storage) only when they no longer fit
+        GLState::BindBuffer(GL_ARRAY_BUFFER, instance_vbo_);
+        if (getCount() > instance_capacity_) {
+            instance_capacity_ = 2 * getCount();
+            glBufferData(GL_ARRAY_BUFFER, instance_capacity_ * sizeof(ParticleInstance), NULL, GL_STREAM_DRAW);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, instances_.size() * sizeof(ParticleInstance), instances_.data());
+
+        // Per-instance attributes, advancing once per instance instead of once per vertex
+        GLint transform_att = glGetAttribLocation(shader_->GetShaderProgram(), "instance_transform");
+        glVertexAttribPointer(transform_att, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), 0);
+        glEnableVertexAttribArray(transform_att);
+        glVertexAttribDivisor(transform_att, 1);
+
+        GLint timing_att = glGetAttribLocation(shader_->GetShaderProgram(), "instance_timing");
+        glVertexAttribPointer(timing_att, 3, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (void*)(4 * sizeof(GLfloat)));
+        glEnableVertexAttribArray(timing_att);
+        glVertexAttribDivisor(timing_att, 1);
+
+        // Bind the particle texture
+        GLState::BindTexture(texture_);
+
+        // Draw every instance
+        GLStats::DrawElementsInstanced(GL_TRIANGLES, particles_->GetSize(), GL_UNSIGNED_INT, 0, getCount());
+
+        // Other shaders may use the same attribute locations without instancing
+        glVertexAttribDivisor(transform_att, 0);
+        glDisableVertexAttribArray(transform_att);
+        glVertexAttribDivisor(timing_att, 0);
+        glDisableVertexAttribArray(timing_att);
+
+        instances_.clear();
+    }
+
+} // namespace game
@@ -0,0 +1,59 @@
+#ifndef PARTICLE_BATCH_H_
+#define PARTICLE_BATCH_H_
+
+#include <vector>
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "geometry.h"
+#include "shader.h"
+
+namespace game {
+
+    // Transform and timing of one particle system, one instance of the batch
+    struct ParticleInstance {
+        float x;
+        float y;
+        float rotation;
+        float scale;
+        float start_time;
+        float cycle;
+        float speed;
+    };
+
+    /*
+        ParticleBatch draws many copies of one particle geometry in a single instanced draw call
+        Each copy only sends its ParticleInstance, the particle motion itself stays in particle_instanced_vertex_shader.glsl
+    */
+    class ParticleBatch {
+
+    public:
+        ParticleBatch(void);
+        ~ParticleBatch();
+
+        // Call once there is an OpenGL context, the shader is the instanced particle shader variant for the particle type
+        void Init(Geometry* particles, Shader* shader, GLuint texture);
+
+        inline void add(const ParticleInstance& instance) { instances_.push_back(instance); };
+        inline int getCount(void) const { return static_cast<int>(instances_.size()); };
+
+        // Draws every instance added since the last render, then clears them
+        void Render(double current_time);
+
+    private:
+        Geometry* particles_ = nullptr;
+        Shader* shader_ = nullptr;
+        GLuint texture_ = 0;
+
+        std::vector<ParticleInstance> instances_;
+
+        // Instance buffer, refilled every frame
+        GLuint instance_vbo_ = 0;
+        int instance_capacity_ = 0;
+
+    }; // class ParticleBatch
+
+} // namespace game
+
+#endif // PARTICLE_BATCH_H_
@@ -0,0 +1,14 @@
+// Source code of fragment shader compositing the offscreen particle target over the scene
+#version 130
+
+// Attributes passed from the vertex shader
+in vec2 uv_interp;
+
+// Texture sampler
+uniform sampler2D onetex;
+
+void main()
+{
+    // Blended additively, as the particles were
+    gl_FragColor = texture2D(onetex, uv_interp);
+}
@@ -0,0 +1,16 @@
+// Source code of vertex shader compositing the offscreen particle target over the scene
+#version 130
+
+// Vertex buffer
+in vec2 vertex; // Corner of the screen, -1 to 1
+
+// Attributes forwarded to the fragment shader
+out vec2 uv_interp;
+
+void main()
+{
+    gl_Position = vec4(vertex, 0.0, 1.0);
+
+    // The target is a render texture, so its origin is the bottom left
+    uv_interp = vertex*0.5 + 0.5;
+}
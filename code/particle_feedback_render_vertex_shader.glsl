@@ -0,0 +1,38 @@
+// Source code of vertex shader for particles kept in GL buffers
+// One quad per instance, each instance reads one particle of the buffer the last update wrote
+#version 130
+#extension GL_ARB_uniform_buffer_object : require
+
+// Vertex buffer
+in vec2 vertex; // Vertex coordinates of the quad
+in vec2 uv; // Texture coordinates
+
+// Instance buffer
+in vec2 position;
+in vec2 life; // Seconds left, lifetime
+in vec3 properties; // Drag, gravity, size
+
+// Per-frame camera, shared by every shader
+layout(std140) uniform Camera {
+    mat4 view_matrix;
+};
+
+// Attributes forwarded to the fragment shader
+out vec4 color_interp;
+out vec2 uv_interp;
+
+void main()
+{
+    // Dead particles collapse to a point
+    float alive = step(0.0, life.x);
+    vec2 pos = position + vertex*properties.z*alive;
+
+    // Transform vertex position
+    gl_Position = view_matrix*vec4(pos, 0.0, 1.0);
+
+    // Set color, fading out with the particle's life
+    color_interp = vec4(max(life.x, 0.0)/max(life.y, 0.0001), 0.0, 0.0, 1.0);
+
+    // Transfer texture coordinates
+    uv_interp = uv;
+}
@@ -0,0 +1,32 @@
+// Source code of vertex shader that advances particles kept in GL buffers
+// Runs once per particle with rasterization off, its outputs are captured with transform feedback into the other buffer
+#version 130
+
+// Particle buffer
+in vec2 position;
+in vec2 velocity;
+in vec2 life; // Seconds left, lifetime
+in vec3 properties; // Drag, gravity, size
+
+// Uniform (global) buffer
+uniform float delta_time;
+
+// Captured in this order, matching the particle buffer
+out vec2 feedback_position;
+out vec2 feedback_velocity;
+out vec2 feedback_life;
+out vec3 feedback_properties;
+
+void main()
+{
+    // Drag scales the velocity down, never past zero, then gravity pulls along y
+    float damping = max(0.0, 1.0 - properties.x*delta_time);
+    vec2 v = velocity*damping + vec2(0.0, properties.y*delta_time);
+
+    feedback_position = position + v*delta_time;
+    feedback_velocity = v;
+    feedback_life = vec2(life.x - delta_time, life.y);
+    feedback_properties = properties;
+
+    gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
+}
@@ -7,25 +7,22 @@ in vec2 uv_interp;
 
 // Texture sampler
 uniform sampler2D onetex;
-uniform int particle_type;
 
-// Constants
-int BULLET_PARTICLE = 10;
-int EXPLOSION_PARTICLE = 11; 
+// Particle type, a #define of the variant ShaderCache built: BULLET_PARTICLE, EXPLOSION_PARTICLE or neither
 
 void main()
 {
     // Sample texture
     vec4 color = texture2D(onetex, uv_interp);
 
-    // check type
-    if (particle_type == BULLET_PARTICLE){
-        color.rgb = vec3(0.91, 0.988, 0.98) * color_interp.r;
-    } else if (particle_type == EXPLOSION_PARTICLE){
-        color.rgb = vec3(0.8, 0.4, 0.01) * color_interp.r;
-    } else {
-        color.rgb = vec3(1.0, 1.0, 1.0) * color_interp.r;
-    }
+    // Tint by type
+#if defined(BULLET_PARTICLE)
+    color.rgb = vec3(0.91, 0.988, 0.98) * color_interp.r;
+#elif defined(EXPLOSION_PARTICLE)
+    color.rgb = vec3(0.8, 0.4, 0.01) * color_interp.r;
+#else
+    color.rgb = vec3(1.0, 1.0, 1.0) * color_interp.r;
+#endif
 
     // Assign color to fragment
     gl_FragColor = vec4(color.r, color.g, color.b, color.a);
@@ -0,0 +1,63 @@
+// Source code of vertex shader for instanced particle systems
+// Same particles as particle_vertex_shader.glsl, with the transform and timing of each system per instance
+#version 130
+#extension GL_ARB_uniform_buffer_object : require
+
+// Vertex buffer
+in vec2 vertex; // Vertex coordinates
+in vec2 dir; // Velocity
+in float t; // Phase
+in vec2 uv; // Texture coordinates
+
+// Instance buffer
+in vec4 instance_transform; // Position (2), rotation, scale
+in vec3 instance_timing; // Start time, duration of cycle in seconds, speed adjustment constant
+
+// Per-frame camera, shared by every shader
+layout(std140) uniform Camera {
+    mat4 view_matrix;
+};
+
+// Uniform (global) buffer
+uniform float current_time; // Timer
+
+// Attributes forwarded to the fragment shader
+out vec4 color_interp;
+out vec2 uv_interp;
+
+// Particle type, a #define of the variant ShaderCache built: BULLET_PARTICLE, EXPLOSION_PARTICLE or neither
+
+void main()
+{
+    vec2 pos; // Vertex position
+    float acttime; // Cyclic time
+
+    float time = current_time - instance_timing.x;
+    float cycle = instance_timing.y;
+    float speed = instance_timing.z;
+
+    // Add phase to the time, explosions play once and everything else cycles
+#ifdef EXPLOSION_PARTICLE
+    acttime = time + t*cycle;
+#else
+    acttime = mod(time + t*cycle, cycle);
+#endif
+
+    // Move particle along given direction
+    pos = vec2(vertex.x + acttime*speed*dir.x , vertex.y + acttime*speed*dir.y);
+
+    // Scale, rotate and translate by the instance
+    pos *= instance_transform.w;
+    float c = cos(instance_transform.z);
+    float s = sin(instance_transform.z);
+    pos = vec2(c*pos.x - s*pos.y, s*pos.x + c*pos.y) + instance_transform.xy;
+
+    // Transform vertex position
+    gl_Position = view_matrix*vec4(pos, 0.0, 1.0);
+    
+    // Set color
+    color_interp = vec4(t, 0.0, 0.0, 1.0);
+
+    // Transfer texture coordinates
+    uv_interp = uv;
+}
@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <glm/gtc/constants.hpp>
+
+#include "particle_simulator.h"
+#include "gl_state.h"
+#include "gl_stats.h"
+#include "helper.h"
+#include "simd.h"
+
+namespace game {
+
+    void ParticleLanes::resize(int count) {
+        position_x.resize(count);
+        position_y.resize(count);
+        velocity_x.resize(count);
+        velocity_y.resize(count);
+        life.resize(count);
+        inverse_lifetime.resize(count);
+        size.resize(count);
+        drag.resize(count);
+        gravity.resize(count);
+    }
+
+
+    ParticleSimulator::ParticleSimulator(void) {
+        // the arrays never grow, so the kernels can always read a whole register past the last particle
+        lanes_.resize(simd::padded(MAX_SIMULATED_PARTICLES));
+    }
+
+
+    ParticleSimulator::~ParticleSimulator() {
+        if (vbo_ != 0) {
+            GLState::DeleteBuffers(1, &vbo_);
+            GLState::DeleteBuffers(1, &ebo_);
+        }
+    }
+
+
+    void ParticleSimulator::Init(Shader* shader, GLuint texture) {
+        shader_ = shader;
+        texture_ = texture;
+
+        glGenBuffers(1, &vbo_);
+
+        // the faces never change, so the index buffer is built once for the most particles there can be
+        std::vector<GLuint> faces(MAX_SIMULATED_PARTICLES * 6);
+        for (int i = 0; i < MAX_SIMULATED_PARTICLES; i++) {
+            faces[i * 6 + 0] = i * 4 + 0;
+            faces[i * 6 + 1] = i * 4 + 1;
+            faces[i * 6 + 2] = i * 4 + 2;
+            faces[i * 6 + 3] = i * 4 + 2;
+            faces[i * 6 + 4] = i * 4 + 3;
+            faces[i * 6 + 5] = i * 4 + 0;
+        }
+        glGenBuffers(1, &ebo_);
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, faces.size() * sizeof(GLuint), faces.data(), GL_STATIC_DRAW);
+    }
+
+
+    int ParticleSimulator::addEmitter(const ParticleEmitter& emitter) {
+        if (!free_emitters_.empty()) {
+            int handle = free_emitters_.back();
+            free_emitters_.pop_back();
+            emitters_[handle] = emitter;
+            return handle;
+        }
+        emitters_.push_back(emitter);
+        return static_cast<int>(emitters_.size()) - 1;
+    }
+
+
+    void ParticleSimulator::removeEmitter(int handle) {
+        emitters_[handle].active = false;
+        free_emitters_.push_back(handle);
+    }
+
+
+    void ParticleSimulator::burst(const ParticleEmitter& emitter, int count) {
+        count = std::min(count, MAX_SIMULATED_PARTICLES - count_);
+        for (int i = 0; i < count; i++) {
+            spawn(emitter);
+        }
+    }
+
+
+    void ParticleSimulator::spawn(const ParticleEmitter& emitter) {
+        if (count_ >= MAX_SIMULATED_PARTICLES) {
+            return;
+        }
+
+        float angle = emitter.direction + Helper::generateFloat(-0.5f, 0.5f) * emitter.spread;
+        float speed = Helper::generateFloat(emitter.min_speed, emitter.max_speed);
+
+        int i = count_++;
+        lanes_.position_x[i] = emitter.position.x;
+        lanes_.position_y[i] = emitter.position.y;
+        lanes_.velocity_x[i] = glm::cos(angle) * speed;
+        lanes_.velocity_y[i] = glm::sin(angle) * speed;
+        lanes_.life[i] = emitter.lifetime;
+        lanes_.inverse_lifetime[i] = 1.0f / emitter.lifetime;
+        lanes_.size[i] = emitter.size;
+        lanes_.drag[i] = emitter.drag;
+        lanes_.gravity[i] = emitter.gravity;
+    }
+
+
+    void ParticleSimulator::remove(int index) {
+        int last = count_ - 1;
+        lanes_.position_x[index] = lanes_.position_x[last];
+        lanes_.position_y[index] = lanes_.position_y[last];
+        lanes_.velocity_x[index] = lanes_.velocity_x[last];
+        lanes_.velocity_y[index] = lanes_.velocity_y[last];
+        lanes_.life[index] = lanes_.life[last];
+        lanes_.inverse_lifetime[index] = lanes_.inverse_lifetime[last];
+        lanes_.size[index] = lanes_.size[last];
+        lanes_.drag[index] = lanes_.drag[last];
+        lanes_.gravity[index] = lanes_.gravity[last];
+        count_--;
+    }
+
+
+    void ParticleSimulator::Update(double delta_time) {
+        float dt = static_cast<float>(delta_time);
+
+        // emit what each emitter's rate owes
+        for (int i = 0; i < emitters_.size(); i++) {
+            ParticleEmitter& emitter = emitters_[i];
+            if (!emitter.active) {
+                continue;
+            }
+            emitter.accumulator += emitter.rate * dt;
+            int owed = static_cast<int>(emitter.accumulator);
+            emitter.accumulator -= owed;
+            burst(emitter, owed);
+        }
+
+        integrateBatch(lanes_, count_, dt);
+
+        // remove dead particles, from the back so swapped in particles are already checked
+        for (int i = simd::padded(count_) - SIMD_WIDTH; i >= 0; i -= SIMD_WIDTH) {
+            if (!simd::any(simd::le(simd::load(&lanes_.life[i]), simd::set1(0.0f)))) {
+                continue;
+            }
+            for (int j = std::min(i + SIMD_WIDTH, count_) - 1; j >= i; j--) {
+                if (lanes_.life[j] <= 0.0f) {
+                    remove(j);
+                }
+            }
+        }
+    }
+
+
+    void ParticleSimulator::integrateBatch(ParticleLanes& lanes, int count, float delta_time) {
+        using namespace simd;
+
+        vfloat dt = set1(delta_time);
+        vfloat zero = set1(0.0f);
+        vfloat one = set1(1.0f);
+
+        for (int i = 0; i < count; i += SIMD_WIDTH) {
+            // drag scales the velocity down, never past zero
+            vfloat damping = max(zero, sub(one, mul(load(&lanes.drag[i]), dt)));
+            vfloat vx = mul(load(&lanes.velocity_x[i]), damping);
+            vfloat vy = add(mul(load(&lanes.velocity_y[i]), damping), mul(load(&lanes.gravity[i]), dt));
+
+            store(&lanes.velocity_x[i], vx);
+            store(&lanes.velocity_y[i], vy);
+            store(&lanes.position_x[i], add(load(&lanes.position_x[i]), mul(vx, dt)));
+            store(&lanes.position_y[i], add(load(&lanes.position_y[i]), mul(vy, dt)));
+            store(&lanes.life[i], sub(load(&lanes.life[i]), dt));
+        }
+    }
+
+
+    void ParticleSimulator::buildVertices(std::vector<float>* vertices) const {
+        // corners of the quad and their texture coordinates, in the order of the faces
+        static const float corners[4][4] = {
+            { -0.5f,  0.5f, 0.0f, 0.0f },
+            {  0.5f,  0.5f, 1.0f, 0.0f },
+            {  0.5f, -0.5f, 1.0f, 1.0f },
+            { -0.5f, -0.5f, 0.0f, 1.0f }
+        };
+
+        vertices->resize(count_ * 4 * 5);
+        float* out = vertices->data();
+        for (int i = 0; i < count_; i++) {
+            float x = lanes_.position_x[i];
+            float y = lanes_.position_y[i];
+            float size = lanes_.size[i];
+            float fade = lanes_.life[i] * lanes_.inverse_lifetime[i];
+            for (int c = 0; c < 4; c++) {
+                *out++ = x + corners[c][0] * size;
+                *out++ = y + corners[c][1] * size;
+                *out++ = corners[c][2];
+                *out++ = corners[c][3];
+                *out++ = fade;
+            }
+        }
+    }
+
+
+    void ParticleSimulator::Render(void) {
+        if (count_ == 0) {
+            return;
+        }
+        GL_STATS_SCOPE("ParticleSimulator::Render");
+
+        buildVertices(&vertices_);
+
+        // Set up the shader
+        shader_->Enable();
+
+        // Set blending, as Particles does
+        GLState::SetDepthTest(false);
+        GLState::SetBlend(true);
+        GLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE);
+
+        // Stream this frame's vertices, letting the driver orphan last frame's storage
+        GLState::BindBuffer(GL_ARRAY_BUFFER, vbo_);
+        glBufferData(GL_ARRAY_BUFFER, vertices_.size() * sizeof(GLfloat), vertices_.data(), GL_STREAM_DRAW);
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+
+        GLint vertex_att = glGetAttribLocation(shader_->GetShaderProgram(), "vertex");
+        glVertexAttribPointer(vertex_att, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), 0);
+        glEnableVertexAttribArray(vertex_att);
+
+        GLint tex_att = glGetAttribLocation(shader_->GetShaderProgram(), "uv");
+        glVertexAttribPointer(tex_att, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (void*)(2 * sizeof(GLfloat)));
+        glEnableVertexAttribArray(tex_att);
+
+        GLint fade_att = glGetAttribLocation(shader_->GetShaderProgram(), "t");
+        glVertexAttribPointer(fade_att, 1, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (void*)(4 * sizeof(GLfloat)));
+        glEnableVertexAttribArray(fade_att);
+
+        // Bind the particle texture
+        GLState::BindTexture(texture_);
+
+        // Draw every particle
+        GLStats::DrawElements(GL_TRIANGLES, count_ * 6, GL_UNSIGNED_INT, 0);
+    }
+
+} // namespace game
@@ -0,0 +1,106 @@
+#ifndef PARTICLE_SIMULATOR_H_
+#define PARTICLE_SIMULATOR_H_
+
+#include <vector>
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "config.h"
+#include "shader.h"
+
+namespace game {
+
+    // Where and how an emitter spawns particles
+    struct ParticleEmitter {
+        glm::vec3 position = glm::vec3(0.0f);
+        float rate = 0.0f;              // particles per second, 0 for bursts only
+        float direction = 0.0f;         // angle of the middle of the spray
+        float spread = 6.2831853f;      // angle of the whole spray, a full circle by default
+        float min_speed = 1.0f;
+        float max_speed = 2.0f;
+        float lifetime = 1.0f;          // seconds
+        float size = 0.2f;
+        float drag = 0.0f;              // fraction of the velocity lost per second
+        float gravity = 0.0f;           // added to the y velocity per second
+        bool active = true;
+
+        float accumulator = 0.0f;       // particles owed by the rate, carried between frames
+    };
+
+    // Per particle state as packed arrays, padded so the kernels can always read whole registers
+    struct ParticleLanes {
+        std::vector<float> position_x;
+        std::vector<float> position_y;
+        std::vector<float> velocity_x;
+        std::vector<float> velocity_y;
+        std::vector<float> life;            // seconds until the particle dies
+        std::vector<float> inverse_lifetime;
+        std::vector<float> size;
+        std::vector<float> drag;
+        std::vector<float> gravity;
+
+        void resize(int count);
+    };
+
+    /*
+        ParticleSimulator moves particles on the CPU, each with its own velocity and lifetime
+        Emitters spawn them at a rate or in bursts, up to MAX_SIMULATED_PARTICLES in total
+        Velocity, drag and gravity are integrated by a SIMD kernel over the packed arrays
+        Every frame the quads of all live particles are streamed to one dynamic vertex buffer and drawn in one call
+    */
+    class ParticleSimulator {
+
+    public:
+        ParticleSimulator(void);
+        ~ParticleSimulator();
+
+        // Call once there is an OpenGL context, the shader is the streamed particle shader variant for the particle type
+        void Init(Shader* shader, GLuint texture);
+
+        // Emitters spawn every update until removed, the returned handle stays valid until then
+        int addEmitter(const ParticleEmitter& emitter);
+        void removeEmitter(int handle);
+        inline ParticleEmitter* getEmitter(int handle) { return &emitters_[handle]; };
+
+        // Spawns count particles at once with the emitter's settings, fewer if the cap is reached
+        void burst(const ParticleEmitter& emitter, int count);
+
+        // Emission, movement and removal of dead particles
+        void Update(double delta_time);
+
+        // Draws every live particle
+        void Render(void);
+
+        // Fills vertices with four (x, y, u, v, fade) vertices per live particle, as Render uploads them
+        void buildVertices(std::vector<float>* vertices) const;
+
+        inline int getCount(void) const { return count_; };
+
+        // Kernel
+        // applies drag and gravity, moves every particle and counts down its life
+        static void integrateBatch(ParticleLanes& lanes, int count, float delta_time);
+
+    private:
+        void spawn(const ParticleEmitter& emitter);
+        // swaps the last particle into index
+        void remove(int index);
+
+        ParticleLanes lanes_;
+        int count_ = 0;
+
+        std::vector<ParticleEmitter> emitters_;
+        std::vector<int> free_emitters_;
+
+        // Rendering
+        Shader* shader_ = nullptr;
+        GLuint texture_ = 0;
+        GLuint vbo_ = 0;
+        GLuint ebo_ = 0;
+        std::vector<float> vertices_;   // scratch
+
+    }; // class ParticleSimulator
+
+} // namespace game
+
+#endif // PARTICLE_SIMULATOR_H_
@@ -0,0 +1,30 @@
+// Source code of vertex shader for particles simulated on the CPU
+// Vertices arrive already moved and sized, one quad per particle
+#version 130
+#extension GL_ARB_uniform_buffer_object : require
+
+// Vertex buffer
+in vec2 vertex; // Vertex coordinates in the world
+in vec2 uv; // Texture coordinates
+in float t; // Remaining fraction of the particle's life
+
+// Per-frame camera, shared by every shader
+layout(std140) uniform Camera {
+    mat4 view_matrix;
+};
+
+// Attributes forwarded to the fragment shader
+out vec4 color_interp;
+out vec2 uv_interp;
+
+void main()
+{
+    // Transform vertex position
+    gl_Position = view_matrix*vec4(vertex, 0.0, 1.0);
+
+    // Set color, fading out with the particle's life
+    color_interp = vec4(t, 0.0, 0.0, 1.0);
+
+    // Transfer texture coordinates
+    uv_interp = uv;
+}
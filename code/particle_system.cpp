@@ -2,6 +2,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "particle_system.h"
+#include "gl_state.h"
+#include "gl_stats.h"
 
 
 namespace game {
@@ -37,32 +39,21 @@ namespace game {
     }
 
 
-    void ParticleSystem::Render(glm::mat4 view_matrix, double temp) {
+    void ParticleSystem::Render(double temp) {
+        GL_STATS_SCOPE("ParticleSystem::Render");
+
         // Set up the shader
         shader_->Enable();
 
-        // Set up the view matrix
-        shader_->SetUniformMat4("view_matrix", view_matrix);
-
-        // Setup the scaling matrix for the shader
-        glm::mat4 scaling_matrix = glm::scale(glm::mat4(1.0f), glm::vec3(scale_.x, scale_.y, 1.0));
-
-        // Setup the rotation matrix for the shader
-        glm::mat4 rotation_matrix = glm::rotate(glm::mat4(1.0f), angle_, glm::vec3(0.0, 0.0, 1.0));
 
-        // Set up the translation matrix for the shader
-        glm::mat4 translation_matrix = glm::translate(glm::mat4(1.0f), position_);
+        // Set up the parent transformation, rotated then translated
+        Transform2D parent_transformation = Transform2D::Make(parent_->GetPosition(), parent_->GetRotation(), glm::vec2(1.0f));
 
-        // Set up the parent transformation matrix
-        glm::mat4 parent_rotation_matrix = glm::rotate(glm::mat4(1.0f), parent_->GetRotation(), glm::vec3(0.0, 0.0, 1.0));
-        glm::mat4 parent_translation_matrix = glm::translate(glm::mat4(1.0f), parent_->GetPosition());
-        glm::mat4 parent_transformation_matrix = parent_translation_matrix * parent_rotation_matrix;
+        // Setup the transformation for the shader, the system's own inside its parent's
+        Transform2D transformation = parent_transformation * Transform2D::Make(position_, angle_, scale_);
 
-        // Setup the transformation matrix for the shader
-        glm::mat4 transformation_matrix = parent_transformation_matrix * translation_matrix * rotation_matrix * scaling_matrix;
-
-        // Set the transformation matrix in the shader
-        shader_->SetUniformMat4("transformation_matrix", transformation_matrix);
+        // Set the transformation in the shader
+        shader_->SetTransform(transformation);
 
         // Set the time in the shader
         shader_->SetUniform1f("time", current_time);
@@ -72,17 +63,14 @@ namespace game {
         shader_->SetUniform1f("speed", speed);
         shader_->SetUniform1f("gravity", gravity);
 
-        // Set the particle type in the shader
-        shader_->SetUniform1i("particle_type", type);
-
         // Set up the geometry
         geometry_->SetGeometry(shader_->GetShaderProgram());
 
         // Bind the particle texture
-        glBindTexture(GL_TEXTURE_2D, texture_);
+        GLState::BindTexture(texture_);
 
         // Draw the entity
-        glDrawElements(GL_TRIANGLES, geometry_->GetSize(), GL_UNSIGNED_INT, 0);
+        GLStats::DrawElements(GL_TRIANGLES, geometry_->GetSize(), GL_UNSIGNED_INT, 0);
     }
 
 } // namespace game
@@ -20,10 +20,11 @@ namespace game {
 
         // Setters
         inline void setParent(GameObject* parent) { parent_ = parent; };
+        inline void setTime(double time) { current_time = time; };
 
         void Update(double delta_time) override;
 
-        void Render(glm::mat4 view_matrix, double current_time);
+        void Render(double current_time);
 
     private:
         GameObject* parent_;
@@ -0,0 +1,118 @@
+#include <algorithm>
+
+#include "particle_target.h"
+#include "gl_state.h"
+#include "gl_stats.h"
+
+namespace game {
+
+    ParticleTarget::ParticleTarget(void) {}
+
+
+    ParticleTarget::~ParticleTarget()
+    {
+        if (framebuffer_ != 0) {
+            glDeleteFramebuffers(1, &framebuffer_);
+            GLState::DeleteTextures(1, &texture_);
+            GLState::DeleteBuffers(1, &quad_vbo_);
+        }
+    }
+
+
+    void ParticleTarget::Init(Shader* composite_shader, int divisor)
+    {
+        shader_ = composite_shader;
+        divisor_ = std::max(divisor, 1);
+
+        glGenFramebuffers(1, &framebuffer_);
+        glGenTextures(1, &texture_);
+
+        // Two triangles covering the screen
+        GLfloat quad[] = {
+            -1.0f, -1.0f,
+             1.0f, -1.0f,
+             1.0f,  1.0f,
+             1.0f,  1.0f,
+            -1.0f,  1.0f,
+            -1.0f, -1.0f
+        };
+        glGenBuffers(1, &quad_vbo_);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, quad_vbo_);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+    }
+
+
+    void ParticleTarget::Resize(int width, int height)
+    {
+        width_ = width;
+        height_ = height;
+
+        // Filtered when stretched back over the screen
+        GLState::BindTexture(texture_);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width_, height_, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture_, 0);
+    }
+
+
+    void ParticleTarget::Bind(void)
+    {
+        // Remember where the scene is drawn
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &screen_framebuffer_);
+        glGetIntegerv(GL_VIEWPORT, screen_viewport_);
+
+        int width = std::max(screen_viewport_[2] / divisor_, 1);
+        int height = std::max(screen_viewport_[3] / divisor_, 1);
+        if (width != width_ || height != height_) {
+            Resize(width, height);
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+        glViewport(0, 0, width_, height_);
+
+        if (!drawn_) {
+            glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            drawn_ = true;
+        }
+    }
+
+
+    void ParticleTarget::Unbind(void)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, screen_framebuffer_);
+        glViewport(screen_viewport_[0], screen_viewport_[1], screen_viewport_[2], screen_viewport_[3]);
+    }
+
+
+    void ParticleTarget::Composite(void)
+    {
+        if (!drawn_) {
+            return;
+        }
+        GL_STATS_SCOPE("ParticleTarget::Composite");
+
+        shader_->Enable();
+
+        // Add the particles over the scene
+        GLState::SetDepthTest(false);
+        GLState::SetBlend(true);
+        GLState::SetBlendFunc(GL_ONE, GL_ONE);
+
+        GLState::BindBuffer(GL_ARRAY_BUFFER, quad_vbo_);
+        GLint vertex_att = glGetAttribLocation(shader_->GetShaderProgram(), "vertex");
+        glVertexAttribPointer(vertex_att, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), 0);
+        glEnableVertexAttribArray(vertex_att);
+
+        GLState::BindTexture(texture_);
+        GLStats::DrawArrays(GL_TRIANGLES, 0, 6);
+
+        drawn_ = false;
+    }
+
+} // namespace game
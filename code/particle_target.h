@@ -0,0 +1,63 @@
+#ifndef PARTICLE_TARGET_H_
+#define PARTICLE_TARGET_H_
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+#include "shader.h"
+
+namespace game {
+
+    /*
+        ParticleTarget is an offscreen color buffer at a fraction of the screen resolution that particles draw into
+        Particles blend additively, so the whole target is added over the scene in one full-screen pass
+        Overlapping particle quads then cost a fraction of the fill
+        Enabled with the USE_REDUCED_RESOLUTION_PARTICLES flag in config.h
+    */
+    class ParticleTarget {
+
+    public:
+        ParticleTarget(void);
+        ~ParticleTarget();
+
+        // Call once there is an OpenGL context
+        // shader is particle_composite_vertex_shader.glsl with particle_composite_fragment_shader.glsl
+        // divisor is how many screen pixels each target pixel covers along each axis
+        void Init(Shader* composite_shader, int divisor);
+
+        // Redirects drawing to the target, clearing it on the first bind of the frame
+        void Bind(void);
+
+        // Goes back to drawing to the screen
+        void Unbind(void);
+
+        // Adds the target over the screen, then starts a new frame
+        void Composite(void);
+
+    private:
+        // Matches the target to the viewport size
+        void Resize(int width, int height);
+
+        Shader* shader_ = nullptr;
+        int divisor_ = 1;
+
+        GLuint framebuffer_ = 0;
+        GLuint texture_ = 0;
+        int width_ = 0;
+        int height_ = 0;
+
+        // Full-screen quad
+        GLuint quad_vbo_ = 0;
+
+        // State restored by Unbind
+        GLint screen_framebuffer_ = 0;
+        GLint screen_viewport_[4] = { 0, 0, 0, 0 };
+
+        // Whether anything was drawn into the target this frame
+        bool drawn_ = false;
+
+    }; // class ParticleTarget
+
+} // namespace game
+
+#endif // PARTICLE_TARGET_H_
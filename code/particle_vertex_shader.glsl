@@ -1,17 +1,21 @@
 // Source code of vertex shader for particle system
 #version 130
+#extension GL_ARB_uniform_buffer_object : require
 
 // Vertex buffer
 in vec2 vertex; // Vertex coordinates
 in vec2 dir; // Velocity
 in float t; // Phase
 in vec2 uv; // Texture coordinates
+in mat2x4 transformation; // Per-object 2D affine transform, its two rows from the transform stream
+
+// Per-frame camera, shared by every shader
+layout(std140) uniform Camera {
+    mat4 view_matrix;
+};
 
 // Uniform (global) buffer
-uniform mat4 transformation_matrix;
-uniform mat4 view_matrix;
 uniform float time; // Timer
-uniform int particle_type;
 
 // Uniform attributes
 uniform float cycle; // Duration of cycle in seconds
@@ -22,25 +26,19 @@ uniform float gravity; // Gravity in this world
 out vec4 color_interp;
 out vec2 uv_interp;
 
-// Constants
-int BULLET_PARTICLE = 10;
-int EXPLOSION_PARTICLE = 11; 
+// Particle type, a #define of the variant ShaderCache built: BULLET_PARTICLE, EXPLOSION_PARTICLE or neither
 
 void main()
 {
     vec4 pos; // Vertex position
     float acttime; // Cyclic time
 
-    // Add phase to the time and cycle it
-
-    // check type
-    if (particle_type == BULLET_PARTICLE){
-        acttime = mod(time + t*cycle, cycle);
-    } else if (particle_type == EXPLOSION_PARTICLE){
-        acttime = time + t*cycle;
-    } else {
-        acttime = mod(time + t*cycle, cycle);
-    }
+    // Add phase to the time, explosions play once and everything else cycles
+#ifdef EXPLOSION_PARTICLE
+    acttime = time + t*cycle;
+#else
+    acttime = mod(time + t*cycle, cycle);
+#endif
 
     // Move particle along given direction
     pos = vec4(vertex.x + acttime*speed*dir.x , vertex.y + acttime*speed*dir.y , 0.0, 1.0);
@@ -55,7 +53,9 @@ void main()
     //pos = vec4(vertex.x, vertex.y, 0.0, 1.0);
 
     // Transform vertex position
-    gl_Position = view_matrix*transformation_matrix*pos;
+    // rows are (a, c, tx, depth) and (b, d, ty, 0)
+    vec4 world_pos = vec4(dot(transformation[0].xyz, pos.xyw), dot(transformation[1].xyz, pos.xyw), transformation[0].w, 1.0);
+    gl_Position = view_matrix*world_pos;
     
     // Set color
     //color_interp = vec4(0.5+0.5*cos(4*acttime),0.5*sin(4*acttime)+0.5,0.5, 1.0);
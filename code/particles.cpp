@@ -3,6 +3,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "particles.h"
+#include "gl_state.h"
 
 namespace game {
 
@@ -84,12 +85,12 @@ namespace game {
 
         // Create buffer for vertices
         glGenBuffers(1, &vbo_);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, vbo_);
         glBufferData(GL_ARRAY_BUFFER, sizeof(particles), particles, GL_STATIC_DRAW);
 
         // Create buffer for faces (index buffer)
         glGenBuffers(1, &ebo_);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(manyfaces), manyfaces, GL_STATIC_DRAW);
 
         // Set number of elements in array buffer
@@ -100,13 +101,13 @@ namespace game {
     void Particles::SetGeometry(GLuint shader_program) {
 
         // Set blending
-        glDisable(GL_DEPTH_TEST);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+        GLState::SetDepthTest(false);
+        GLState::SetBlend(true);
+        GLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE);
 
         // Bind buffers
-        glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, vbo_);
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
 
         // Set attributes for shaders
         // Should be consistent with how we created the buffers for the particle elements
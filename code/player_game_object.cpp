@@ -181,15 +181,15 @@ namespace game
     }
 
     // override parent's render method
-    void PlayerGameObject::Render(glm::mat4 view_matrix, double current_time)
+    void PlayerGameObject::Render(double current_time)
     {
         // call the parent's render method
-        GameObject::Render(view_matrix, current_time);
+        GameObject::Render(current_time);
 
         // Render all child objects
         for (auto child : child_objects_)
         {
-            child->Render(view_matrix, current_time);
+            child->Render(current_time);
         }
     }
 
@@ -213,10 +213,7 @@ namespace game
                     if (turret->GetType() == TurretType::CANNON) {
                         continue;
                     }
-                    auto* new_bullet = turret->Fire();
-                    if (new_bullet != nullptr) {
-                        bullets.push_back(new_bullet);
-                    }
+                    turret->Fire(bullets);
                 }
             }
         }
@@ -226,13 +223,8 @@ namespace game
                 if (dynamic_cast<TurretObject*>(child) != nullptr) {
                     auto* turret = dynamic_cast<TurretObject*>(child);
                     if (turret->GetType() == TurretType::CANNON) {
-                        auto* new_bullet = turret->Fire();
-                        if (new_bullet != nullptr) {
-                            bullets.push_back(new_bullet);
-                        }
-
                         // if the player shot a cannonball, propel the player forward
-                        if (new_bullet != nullptr) {
+                        if (turret->Fire(bullets)) {
                             current_velocity_ += GetBearing() * 10.0f;
                         }
                     }
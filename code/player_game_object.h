@@ -22,6 +22,7 @@ namespace game
         inline void SetMovementInput(glm::vec2 movement_input) { this->movement_input = movement_input; };
         void takeDamage(float damage) override;
         void SetDefaultTurret(TurretObject* turret) { default_turret_ = turret; };
+        inline void SetVelocity(glm::vec3 velocity) { current_velocity_ = velocity; };
 
         // Getters
         inline glm::vec3 GetVelocity() { return current_velocity_; };
@@ -43,9 +44,10 @@ namespace game
 
         // Update function for moving the player object around
         void Update(double delta_time) override;
-        void Render(glm::mat4 view_matrix, double current_time) override;
+        void Render(double current_time) override;
 
         // Turret-related functions
+        // cursor_position is in world space
         void TurnTurrets(const glm::vec2 cursor_position, double delta_time);
         void ShootTurrets(std::vector<GameObject*>& bullets, WeaponShootKey key);
         void SetTurret(TurretObject* turret);
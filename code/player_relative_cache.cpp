@@ -0,0 +1,57 @@
+#include <limits>
+
+#include "player_relative_cache.h"
+#include "game_object.h"
+#include "simd.h"
+
+namespace game {
+
+	PlayerRelativeCache::PlayerRelativeCache() {}
+
+
+	void PlayerRelativeCache::update(const std::vector<GameObject*>& objects, glm::vec3 player_position) {
+		count = static_cast<int>(objects.size());
+		int padded_count = simd::padded(count);
+		if (padded_count > position_x_.size()) {
+			position_x_.resize(padded_count);
+			position_y_.resize(padded_count);
+			distance_.resize(padded_count);
+			direction_x_.resize(padded_count);
+			direction_y_.resize(padded_count);
+		}
+
+		// gather, padding and null objects sit on the player and are marked afterwards
+		for (int i = 0; i < padded_count; i++) {
+			if (i < count && objects[i] != nullptr) {
+				glm::vec3 position = objects[i]->GetPosition();
+				position_x_[i] = position.x;
+				position_y_[i] = position.y;
+			}
+			else {
+				position_x_[i] = player_position.x;
+				position_y_[i] = player_position.y;
+			}
+		}
+
+		using namespace simd;
+		vfloat player_x = set1(player_position.x);
+		vfloat player_y = set1(player_position.y);
+		vfloat zero = set1(0.0f);
+		for (int i = 0; i < padded_count; i += SIMD_WIDTH) {
+			vfloat dx = sub(player_x, load(&position_x_[i]));
+			vfloat dy = sub(player_y, load(&position_y_[i]));
+			vfloat length = sqrt(add(mul(dx, dx), mul(dy, dy)));
+			vfloat inverse_length = select(gt(length, zero), div(set1(1.0f), length), zero);
+			store(&distance_[i], length);
+			store(&direction_x_[i], mul(dx, inverse_length));
+			store(&direction_y_[i], mul(dy, inverse_length));
+		}
+
+		for (int i = 0; i < count; i++) {
+			if (objects[i] == nullptr) {
+				distance_[i] = std::numeric_limits<float>::max();
+			}
+		}
+	}
+
+} // namespace game
@@ -0,0 +1,43 @@
+#ifndef PLAYER_RELATIVE_CACHE_H_
+#define PLAYER_RELATIVE_CACHE_H_
+
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace game {
+
+	class GameObject;
+
+	/*
+		PlayerRelativeCache holds the distance and direction from a group of objects to the player,
+		computed in one SIMD pass so the rest of the frame does not call glm::length again.
+		Entry i belongs to objects[i] of the last update
+	*/
+	class PlayerRelativeCache {
+
+	public:
+		PlayerRelativeCache();
+
+		// null objects get an infinite distance
+		void update(const std::vector<GameObject*>& objects, glm::vec3 player_position);
+
+		// getters
+		inline int getCount() const { return count; };
+		inline float getDistance(int index) const { return distance_[index]; };
+		// unit vector from the object to the player, zero if they overlap exactly
+		inline glm::vec3 getDirection(int index) const { return glm::vec3(direction_x_[index], direction_y_[index], 0.0f); };
+
+	private:
+		int count = 0;
+
+		std::vector<float> position_x_;
+		std::vector<float> position_y_;
+		std::vector<float> distance_;
+		std::vector<float> direction_x_;
+		std::vector<float> direction_y_;
+
+	}; // class PlayerRelativeCache
+
+} // namespace game
+
+#endif // PLAYER_RELATIVE_CACHE_H_
@@ -0,0 +1,389 @@
+#include <algorithm>
+#include <glm/gtc/constants.hpp>
+
+#include "projectile_system.h"
+#include "bullet_object.h"
+#include "enemy_game_object.h"
+#include "player_game_object.h"
+#include "gl_state.h"
+#include "gl_stats.h"
+#include "simd.h"
+
+namespace game {
+
+    void ProjectileLanes::resize(int count) {
+        position_x.resize(count);
+        position_y.resize(count);
+        direction_x.resize(count);
+        direction_y.resize(count);
+        speed.resize(count);
+        damage.resize(count);
+        life.resize(count);
+        scale.resize(count);
+        kind.resize(count);
+        shooter.resize(count);
+        target_x.resize(count);
+        target_y.resize(count);
+        target_found.resize(count);
+        id.resize(count);
+    }
+
+
+    ProjectileSystem::ProjectileSystem() {}
+
+
+    ProjectileSystem::~ProjectileSystem() {
+        for (int i = 0; i < kinds_.size(); i++) {
+            delete kinds_[i].stamp;
+        }
+    }
+
+
+    void ProjectileSystem::setUp(std::vector<GameObject*>* enemies, const KdTree* enemy_tree, PlayerGameObject* player) {
+        enemies_ = enemies;
+        enemy_tree_ = enemy_tree;
+        player_ = player;
+    }
+
+
+    int ProjectileSystem::findKind(BulletObject* bullet) {
+        for (int i = 0; i < kinds_.size(); i++) {
+            if (kinds_[i].bullet == bullet) {
+                return i;
+            }
+        }
+
+        Kind kind;
+        kind.bullet = bullet;
+        kind.stamp = new BulletObject(*bullet);
+        kind.lifetime = bullet->GetExpirationTime();
+        kind.weight = bullet->getWeight();
+        kind.homing = bullet->GetBulletType() == BulletType::HOMING;
+        kind.pierce = bullet->GetBulletType() == BulletType::CANNONBALL;
+        kinds_.push_back(kind);
+        return static_cast<int>(kinds_.size()) - 1;
+    }
+
+
+    void ProjectileSystem::fire(BulletObject* bullet, glm::vec3 position, glm::vec3 direction, float scale, ObjectType shooter_type) {
+        int kind = findKind(bullet);
+
+        int slot = count_++;
+        // lanes only ever grow
+        if (simd::padded(count_) > lanes_.position_x.size()) {
+            lanes_.resize(simd::padded(2 * count_));
+        }
+
+        lanes_.position_x[slot] = position.x;
+        lanes_.position_y[slot] = position.y;
+        lanes_.direction_x[slot] = direction.x;
+        lanes_.direction_y[slot] = direction.y;
+        lanes_.speed[slot] = bullet->GetSpeed();
+        lanes_.damage[slot] = bullet->GetDamage();
+        lanes_.life[slot] = kinds_[kind].lifetime;
+        lanes_.scale[slot] = scale;
+        lanes_.kind[slot] = kind;
+        lanes_.shooter[slot] = shooter_type;
+        lanes_.target_found[slot] = 0;
+        lanes_.id[slot] = next_id_++;
+    }
+
+
+    void ProjectileSystem::Update(double delta_time) {
+        float dt = static_cast<float>(delta_time);
+
+        // homing turns before moving, like BulletObject::Update
+        for (int i = 0; i < count_; i++) {
+            if (kinds_[lanes_.kind[i]].homing) {
+                home(i, dt);
+            }
+        }
+
+        integrateBatch(lanes_, count_, dt);
+
+        // remove expired projectiles, from the back so swapped in projectiles are already checked
+        for (int i = simd::padded(count_) - SIMD_WIDTH; i >= 0; i -= SIMD_WIDTH) {
+            if (!simd::any(simd::le(simd::load(&lanes_.life[i]), simd::set1(0.0f)))) {
+                continue;
+            }
+            for (int j = std::min(i + SIMD_WIDTH, count_) - 1; j >= i; j--) {
+                if (lanes_.life[j] <= 0.0f) {
+                    remove(j);
+                }
+            }
+        }
+    }
+
+
+    void ProjectileSystem::home(int index, float delta_time) {
+        float x = lanes_.position_x[index];
+        float y = lanes_.position_y[index];
+        float dx = lanes_.direction_x[index];
+        float dy = lanes_.direction_y[index];
+
+        // find the closest enemy, probing from the same point as BulletObject (along its sprite's bearing)
+        if (!lanes_.target_found[index] && enemy_tree_ != nullptr) {
+            float length = glm::sqrt(dx * dx + dy * dy);
+            glm::vec3 probe = glm::vec3(x + dy / length * 0.5f, y - dx / length * 0.5f, 0.0f);
+            GameObject* enemy = enemy_tree_->nearest(probe, MAX_HOMING_DISTANCE);
+            if (enemy != nullptr) {
+                lanes_.target_x[index] = enemy->GetPosition().x;
+                lanes_.target_y[index] = enemy->GetPosition().y;
+                lanes_.target_found[index] = 1;
+            }
+        }
+
+        // if an enemy is found, slowly change direction to face the enemy
+        if (lanes_.target_found[index]) {
+            glm::vec2 to_target = glm::vec2(lanes_.target_x[index] - x, lanes_.target_y[index] - y);
+            float distance = glm::length(to_target);
+            if (distance > 0.3f) {
+                glm::vec2 direction = to_target / distance;
+                lanes_.direction_x[index] += (direction.x - dx) * delta_time;
+                lanes_.direction_y[index] += (direction.y - dy) * delta_time;
+            }
+            else {
+                lanes_.target_found[index] = 0;
+            }
+        }
+    }
+
+
+    void ProjectileSystem::Collide(double delta_time) {
+        float dt = static_cast<float>(delta_time);
+
+        // enemy projectiles against the player, every projectile in one batch
+        if (player_ != nullptr && count_ > 0) {
+            glm::vec2 player_position = glm::vec2(player_->GetPosition().x, player_->GetPosition().y);
+            rayCircleBatch(lanes_, count_, player_position, player_->getHitbox(), dt, &hit_time_);
+
+            for (int i = 0; i < count_; i++) {
+                if (lanes_.shooter[i] != ObjectType::Enemy || hit_time_[i] < 0.0f) {
+                    continue;
+                }
+                glm::vec3 position = glm::vec3(lanes_.position_x[i], lanes_.position_y[i], 0.0f);
+                player_->takeDamage(lanes_.damage[i]);
+                player_->knockback(position, kinds_[lanes_.kind[i]].weight, 0.5f);
+                lanes_.life[i] = 0.0f;
+            }
+        }
+
+        // player projectiles against the enemies they can reach this frame
+        if (enemies_ != nullptr && enemy_tree_ != nullptr) {
+            for (int i = 0; i < count_; i++) {
+                if (lanes_.shooter[i] != ObjectType::Player) {
+                    continue;
+                }
+
+                glm::vec2 position = glm::vec2(lanes_.position_x[i], lanes_.position_y[i]);
+                glm::vec2 velocity = glm::vec2(lanes_.direction_x[i], lanes_.direction_y[i]) * lanes_.speed[i];
+                float reach = glm::length(velocity) * dt + MAX_ENEMY_SIZE / 2;
+                enemy_tree_->withinRadius(glm::vec3(position, 0.0f), reach, &nearby_enemies_);
+                // enemies spawned since the tree was built
+                for (int j = enemy_tree_->getCount(); j < enemies_->size(); j++) {
+                    nearby_enemies_.push_back((*enemies_)[j]);
+                }
+
+                // the enemy reached first
+                EnemyGameObject* enemy_hit = nullptr;
+                float collision_time = dt;
+                for (int j = 0; j < nearby_enemies_.size(); j++) {
+                    GameObject* enemy = nearby_enemies_[j];
+                    glm::vec2 center = glm::vec2(enemy->GetPosition().x, enemy->GetPosition().y);
+                    float t = rayCircle(position, velocity, center, enemy->getHitbox());
+                    if (t >= 0.0f && t <= collision_time) {
+                        enemy_hit = static_cast<EnemyGameObject*>(enemy);
+                        collision_time = t;
+                    }
+                }
+                if (enemy_hit == nullptr) {
+                    continue;
+                }
+
+                glm::vec3 bullet_position = glm::vec3(position, 0.0f);
+                if (kinds_[lanes_.kind[i]].pierce) {
+                    if (pierce(i, enemy_hit)) {
+                        enemy_hit->takeDamage(lanes_.damage[i], bullet_position);
+                        enemy_hit->knockback(bullet_position, kinds_[lanes_.kind[i]].weight, 1.0f);
+                    }
+                }
+                else {
+                    enemy_hit->takeDamage(lanes_.damage[i], bullet_position);
+                    enemy_hit->knockback(bullet_position, kinds_[lanes_.kind[i]].weight, 1.0f);
+                    lanes_.life[i] = 0.0f;
+                }
+            }
+        }
+
+        // remove spent projectiles
+        for (int i = count_ - 1; i >= 0; i--) {
+            if (lanes_.life[i] <= 0.0f) {
+                remove(i);
+            }
+        }
+    }
+
+
+    bool ProjectileSystem::pierce(int index, GameObject* object) {
+        int id = lanes_.id[index];
+        for (int i = 0; i < pierce_hits_.size(); i++) {
+            if (pierce_hits_[i].first == id && pierce_hits_[i].second == object) {
+                return false;
+            }
+        }
+        pierce_hits_.push_back(std::make_pair(id, object));
+        return true;
+    }
+
+
+    void ProjectileSystem::forget(GameObject* object) {
+        pierce_hits_.erase(std::remove_if(pierce_hits_.begin(), pierce_hits_.end(),
+            [object](const std::pair<int, GameObject*>& hit) { return hit.second == object; }), pierce_hits_.end());
+    }
+
+
+    void ProjectileSystem::remove(int index) {
+        if (kinds_[lanes_.kind[index]].pierce) {
+            int id = lanes_.id[index];
+            pierce_hits_.erase(std::remove_if(pierce_hits_.begin(), pierce_hits_.end(),
+                [id](const std::pair<int, GameObject*>& hit) { return hit.first == id; }), pierce_hits_.end());
+        }
+
+        int last = --count_;
+        lanes_.position_x[index] = lanes_.position_x[last];
+        lanes_.position_y[index] = lanes_.position_y[last];
+        lanes_.direction_x[index] = lanes_.direction_x[last];
+        lanes_.direction_y[index] = lanes_.direction_y[last];
+        lanes_.speed[index] = lanes_.speed[last];
+        lanes_.damage[index] = lanes_.damage[last];
+        lanes_.life[index] = lanes_.life[last];
+        lanes_.scale[index] = lanes_.scale[last];
+        lanes_.kind[index] = lanes_.kind[last];
+        lanes_.shooter[index] = lanes_.shooter[last];
+        lanes_.target_x[index] = lanes_.target_x[last];
+        lanes_.target_y[index] = lanes_.target_y[last];
+        lanes_.target_found[index] = lanes_.target_found[last];
+        lanes_.id[index] = lanes_.id[last];
+    }
+
+
+    void ProjectileSystem::Render(double current_time) {
+        GL_STATS_SCOPE("ProjectileSystem::Render");
+
+        for (int k = 0; k < kinds_.size(); k++) {
+            const Kind& kind = kinds_[k];
+            BulletObject* stamp = kind.stamp;
+
+            instances_.clear();
+            for (int i = 0; i < count_; i++) {
+                if (lanes_.kind[i] != k) {
+                    continue;
+                }
+
+                glm::vec3 position = glm::vec3(lanes_.position_x[i], lanes_.position_y[i], 0.0f);
+                float angle = glm::atan(lanes_.direction_y[i], lanes_.direction_x[i]) - glm::pi<float>() / 2.0f;
+                instances_.push_back(Transform2D::Make(position, angle, glm::vec2(lanes_.scale[i])));
+
+                stamp->SetPosition(position);
+                stamp->SetRotation(angle);
+                stamp->SetScale(lanes_.scale[i]);
+                // the trail animates by the time since the shot
+                stamp->SetTrailStartTime(current_time - (kind.lifetime - lanes_.life[i]));
+                stamp->AddTrail();
+            }
+            if (instances_.empty()) {
+                continue;
+            }
+
+            Shader* shader = stamp->getShader();
+            Geometry* geometry = stamp->getGeometry();
+            shader->Enable();
+            geometry->SetGeometry(shader->GetShaderProgram());
+            GLState::BindTexture(stamp->getTexture());
+            if (shader->SetInstanceTransforms(instances_.data(), static_cast<int>(instances_.size()))) {
+                GLStats::DrawElementsInstanced(GL_TRIANGLES, geometry->GetSize(), GL_UNSIGNED_INT, 0, static_cast<GLsizei>(instances_.size()));
+                shader->ResetTransform();
+            }
+            else {
+                // no stream, or it is full this frame
+                for (int i = 0; i < instances_.size(); i++) {
+                    shader->SetTransform(instances_[i]);
+                    GLStats::DrawElements(GL_TRIANGLES, geometry->GetSize(), GL_UNSIGNED_INT, 0);
+                }
+            }
+        }
+    }
+
+
+    void ProjectileSystem::integrateBatch(ProjectileLanes& lanes, int count, float delta_time) {
+        using namespace simd;
+
+        vfloat dt = set1(delta_time);
+
+        for (int i = 0; i < count; i += SIMD_WIDTH) {
+            vfloat step = mul(load(&lanes.speed[i]), dt);
+            store(&lanes.position_x[i], add(load(&lanes.position_x[i]), mul(load(&lanes.direction_x[i]), step)));
+            store(&lanes.position_y[i], add(load(&lanes.position_y[i]), mul(load(&lanes.direction_y[i]), step)));
+            store(&lanes.life[i], sub(load(&lanes.life[i]), dt));
+        }
+    }
+
+
+    void ProjectileSystem::rayCircleBatch(const ProjectileLanes& lanes, int count, glm::vec2 center, float radius, float delta_time, std::vector<float>* hit_time) {
+        using namespace simd;
+
+        if (hit_time->size() < simd::padded(count)) {
+            hit_time->resize(simd::padded(count));
+        }
+
+        vfloat zero = set1(0.0f);
+        vfloat none = set1(-1.0f);
+        vfloat center_x = set1(center.x);
+        vfloat center_y = set1(center.y);
+        vfloat radius_squared = set1(radius * radius);
+        vfloat dt = set1(delta_time);
+
+        for (int i = 0; i < count; i += SIMD_WIDTH) {
+            vfloat speed = load(&lanes.speed[i]);
+            vfloat vx = mul(load(&lanes.direction_x[i]), speed);
+            vfloat vy = mul(load(&lanes.direction_y[i]), speed);
+            vfloat rx = sub(load(&lanes.position_x[i]), center_x);
+            vfloat ry = sub(load(&lanes.position_y[i]), center_y);
+
+            // solve |r + v t| = radius, no real root (nan) compares false below
+            vfloat a = add(mul(vx, vx), mul(vy, vy));
+            vfloat b = mul(set1(2.0f), add(mul(vx, rx), mul(vy, ry)));
+            vfloat c = sub(add(mul(rx, rx), mul(ry, ry)), radius_squared);
+            vfloat root = sqrt(sub(mul(b, b), mul(set1(4.0f), mul(a, c))));
+            vfloat two_a = mul(set1(2.0f), a);
+            vfloat t1 = div(sub(root, b), two_a);
+            vfloat t2 = div(sub(negate(b), root), two_a);
+
+            // t2 <= t1, the first time that is not in the past
+            vfloat t = select(ge(t2, zero), t2, select(ge(t1, zero), t1, none));
+            vmask hit = mask_and(ge(t, zero), le(t, dt));
+            store(&(*hit_time)[i], select(hit, t, none));
+        }
+    }
+
+
+    float ProjectileSystem::rayCircle(glm::vec2 position, glm::vec2 velocity, glm::vec2 center, float radius) {
+        glm::vec2 r = position - center;
+        float a = glm::dot(velocity, velocity);
+        float b = 2.0f * glm::dot(velocity, r);
+        float c = glm::dot(r, r) - radius * radius;
+
+        float discriminant = b * b - 4 * a * c;
+        if (discriminant < 0.0f || a == 0.0f) {
+            return -1.0f;
+        }
+        float root = glm::sqrt(discriminant);
+        float t1 = (-b + root) / (2 * a);
+        float t2 = (-b - root) / (2 * a);
+        if (t2 >= 0.0f) {
+            return t2;
+        }
+        return t1 >= 0.0f ? t1 : -1.0f;
+    }
+
+} // namespace game
@@ -0,0 +1,120 @@
+#ifndef PROJECTILE_SYSTEM_H_
+#define PROJECTILE_SYSTEM_H_
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "config.h"
+#include "kd_tree.h"
+#include "transform2d.h"
+
+namespace game {
+
+    class BulletObject;
+    class GameObject;
+    class PlayerGameObject;
+
+    // Per projectile state as packed arrays, padded so the kernels can always read whole registers
+    struct ProjectileLanes {
+        std::vector<float> position_x;
+        std::vector<float> position_y;
+        std::vector<float> direction_x;
+        std::vector<float> direction_y;
+        std::vector<float> speed;
+        std::vector<float> damage;
+        std::vector<float> life;            // seconds until expiry
+        std::vector<float> scale;
+        std::vector<int> kind;              // index into the registered bullet templates
+        std::vector<ObjectType> shooter;
+
+        // homing target
+        std::vector<float> target_x;
+        std::vector<float> target_y;
+        std::vector<char> target_found;
+
+        // unique per shot, keys the pierce hits
+        std::vector<int> id;
+
+        void resize(int count);
+    };
+
+    /*
+        ProjectileSystem simulates bullets as plain data instead of one BulletObject each
+        Bullet templates become kinds the first time they are fired, a projectile only keeps its per-shot state
+        Integration and expiry run as SIMD kernels over the packed arrays, hits are found with batched ray-circle tests
+        Enabled with the USE_PROJECTILE_SYSTEM flag in config.h
+    */
+    class ProjectileSystem {
+
+    public:
+        ProjectileSystem();
+        ~ProjectileSystem();
+
+        // targets for homing and collision
+        void setUp(std::vector<GameObject*>* enemies, const KdTree* enemy_tree, PlayerGameObject* player);
+
+        // adds a shot of the template bullet
+        void fire(BulletObject* bullet, glm::vec3 position, glm::vec3 direction, float scale, ObjectType shooter_type);
+
+        // homing, movement and expiry
+        void Update(double delta_time);
+
+        // damage and knockback on whatever the projectiles hit before the next update, removing spent projectiles
+        void Collide(double delta_time);
+
+        // draws the projectiles of each kind in one instanced draw, and queues their trails
+        void Render(double current_time);
+
+        // drops the pierce hits on object, which is about to be deleted, so an object reusing its address can still be hit
+        void forget(GameObject* object);
+
+        inline int getCount() const { return count_; };
+
+        // Kernels
+        // moves every projectile along its direction and counts down its life
+        static void integrateBatch(ProjectileLanes& lanes, int count, float delta_time);
+        // time until each projectile reaches the circle, -1 if it does not within delta_time
+        static void rayCircleBatch(const ProjectileLanes& lanes, int count, glm::vec2 center, float radius, float delta_time, std::vector<float>* hit_time);
+        // the same test for one projectile, -1 if it never reaches the circle
+        static float rayCircle(glm::vec2 position, glm::vec2 velocity, glm::vec2 center, float radius);
+
+    private:
+        struct Kind {
+            BulletObject* bullet;       // the template, compared on fire
+            BulletObject* stamp;        // copy moved to each projectile to queue its trail
+            float lifetime;
+            float weight;
+            bool homing;
+            bool pierce;
+        };
+
+        int findKind(BulletObject* bullet);
+        void home(int index, float delta_time);
+        // whether a pierce projectile has not hit the object yet, recording the hit
+        bool pierce(int index, GameObject* object);
+        // swaps the last projectile into index
+        void remove(int index);
+
+        std::vector<Kind> kinds_;
+        ProjectileLanes lanes_;
+        int count_ = 0;
+        int next_id_ = 0;
+
+        // objects each pierce projectile already hit, by projectile id
+        std::vector<std::pair<int, GameObject*>> pierce_hits_;
+
+        // scratch
+        std::vector<float> hit_time_;
+        std::vector<Transform2D> instances_;
+        std::vector<GameObject*> nearby_enemies_;
+
+        // targets
+        std::vector<GameObject*>* enemies_ = nullptr;
+        const KdTree* enemy_tree_ = nullptr;
+        PlayerGameObject* player_ = nullptr;
+
+    }; // class ProjectileSystem
+
+} // namespace game
+
+#endif // PROJECTILE_SYSTEM_H_
@@ -1,11 +1,11 @@
 #ifndef RANGED_ENEMY_OBJECT_H_
 #define RANGED_ENEMY_OBJECT_H_
 
-#include "enemy_game_object.h"
+#include "enemy_archetype.h"
 
 namespace game {
 
-	class RangedEnemyObject : public EnemyGameObject {
+	class RangedEnemyObject final : public EnemyArchetype<RangedEnemyObject, EnemyType::RANGED_ENEMY> {
 
 	public:
 		RangedEnemyObject(const glm::vec3& position, Geometry* geom, Shader* shader, GLuint texture, PlayerGameObject* player, std::vector<GameObject*>* bullet_vector);
@@ -17,18 +17,13 @@ namespace game {
 			this->bullet = bullet;
 		}
 
-		// identify
-		inline bool isRangedType() override { return true; };
-
 		// engage action
 		void engageAction(double delta_time) override;
 		void fire();
 
 	private:
-		float min_engage_range = RANGED_ENEMY_MIN_ENGAGE_RANGE;
-		float max_engage_range = RANGED_ENEMY_MAX_ENGAGE_RANGE;
-
-		float rate_of_fire = RANGED_ENEMY_RATE_OF_FIRE;
+		// fires once aimed
+		void facingTarget(void) override { fire(); };
 
 		// Timer
 		Timer fire_cooldown_timer;
@@ -0,0 +1,48 @@
+#include <algorithm>
+
+#include "render_queue.h"
+
+namespace game {
+
+    uint64_t RenderQueue::MakeKey(RenderPass pass, int layer, GLuint program, GLuint texture, GLuint vertex_buffer)
+    {
+        // pass 2 bits, layer 6, program 8, texture 16, vertex buffer 16, the low 16 bits stay clear
+        return (static_cast<uint64_t>(pass) & 0x3) << 62
+             | (static_cast<uint64_t>(layer) & 0x3F) << 56
+             | (static_cast<uint64_t>(program) & 0xFF) << 48
+             | (static_cast<uint64_t>(texture) & 0xFFFF) << 32
+             | (static_cast<uint64_t>(vertex_buffer) & 0xFFFF) << 16;
+    }
+
+
+    uint64_t RenderQueue::MakeKey(RenderPass pass, int layer)
+    {
+        return MakeKey(pass, layer, 0, 0, 0);
+    }
+
+
+    void RenderQueue::clear(void)
+    {
+        items_.clear();
+    }
+
+
+    void RenderQueue::push(uint64_t key, GameObject* object)
+    {
+        items_.push_back({ key, object, RenderSystem::NONE });
+    }
+
+
+    void RenderQueue::push(uint64_t key, RenderSystem system)
+    {
+        items_.push_back({ key, nullptr, system });
+    }
+
+
+    void RenderQueue::sort(void)
+    {
+        // a frame is a few hundred draws, where a comparison sort is as fast as anything
+        std::stable_sort(items_.begin(), items_.end(), [](const RenderItem& a, const RenderItem& b) { return a.key < b.key; });
+    }
+
+} // namespace game
@@ -0,0 +1,55 @@
+#ifndef RENDER_QUEUE_H_
+#define RENDER_QUEUE_H_
+
+#include <cstdint>
+#include <vector>
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+#include "config.h"
+#include "game_object.h"
+
+namespace game {
+
+    // One draw of the frame, either a game object with its children or a batched system
+    struct RenderItem {
+        uint64_t key;
+        GameObject* object;
+        RenderSystem system;
+    };
+
+    /*
+        RenderQueue collects the frame's draws with packed sort keys and puts them in key order
+        From the top bits down a key holds the pass, the layer, the shader program, the texture and the vertex buffer,
+        so each pass runs as one block and draws sharing a program and texture end up next to each other
+        The sort is stable, draws with the same key keep the order they were submitted in; depth tested sprites at the same
+        depth overlap in draw order, so their keys leave the state bits clear
+    */
+    class RenderQueue {
+
+    public:
+        static uint64_t MakeKey(RenderPass pass, int layer, GLuint program, GLuint texture, GLuint vertex_buffer);
+
+        // Key of a draw that has to keep its place in the layer, like a sprite that can overlap others at its depth
+        static uint64_t MakeKey(RenderPass pass, int layer);
+
+        inline static RenderPass getPass(uint64_t key) { return static_cast<RenderPass>(key >> 62); };
+
+        void clear(void);
+        void push(uint64_t key, GameObject* object);
+        void push(uint64_t key, RenderSystem system);
+
+        // Puts the items in key order
+        void sort(void);
+
+        inline int getCount(void) const { return static_cast<int>(items_.size()); };
+        inline const RenderItem& getItem(int i) const { return items_[i]; };
+
+    private:
+        std::vector<RenderItem> items_;
+
+    }; // class RenderQueue
+
+} // namespace game
+
+#endif // RENDER_QUEUE_H_
@@ -4,6 +4,8 @@
 
 #include "file_utils.h"
 #include "shader.h"
+#include "gl_state.h"
+#include "gl_stats.h"
 
 namespace game {
 
@@ -13,72 +15,129 @@ Shader::Shader(void)
 
     // Only initialize variables with default values
     shader_program_ = 0;
+    transforms_ = nullptr;
+    transform_location_ = -1;
 }
 
 
 void Shader::Init(const char *vertPath, const char *fragPath)
 {
-   
+
+    // Compile the vertex and fragment programs
+    GLuint vs = Compile(GL_VERTEX_SHADER, vertPath);
+    GLuint fs = Compile(GL_FRAGMENT_SHADER, fragPath);
+
+    Init(vs, fs);
+
+    // Delete memory used by shaders, since they were already compiled
+    // and linked
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+}
+
+
+void Shader::InitFeedback(const char *vertPath, const std::vector<const char *> &varyings)
+{
+
+    GLuint vs = Compile(GL_VERTEX_SHADER, vertPath);
+    InitFeedback(vs, varyings);
+    glDeleteShader(vs);
+}
+
+
+void Shader::Init(GLuint vertex_shader, GLuint fragment_shader)
+{
+
+    // Create a shader program linking both vertex and fragment shaders
+    // together
+    shader_program_ = glCreateProgram();
+    glAttachShader(shader_program_, vertex_shader);
+    glAttachShader(shader_program_, fragment_shader);
+    Link();
+
+    transform_location_ = glGetAttribLocation(shader_program_, "transformation");
+}
+
+
+void Shader::InitFeedback(GLuint vertex_shader, const std::vector<const char *> &varyings)
+{
+
+    // The captured outputs have to be named before linking
+    shader_program_ = glCreateProgram();
+    glAttachShader(shader_program_, vertex_shader);
+    glTransformFeedbackVaryings(shader_program_, static_cast<GLsizei>(varyings.size()), varyings.data(), GL_INTERLEAVED_ATTRIBS);
+    Link();
+}
+
+
+GLuint Shader::Compile(GLenum type, const char *path, const std::vector<std::string> &defines)
+{
+
     // Load shader program source code
-    // Vertex program
-    std::string vp = LoadTextFile(vertPath);
-    const char *source_vp = vp.c_str();
-    // Fragment program
-    std::string fp = LoadTextFile(fragPath);
-    const char *source_fp = fp.c_str();
-
-    // Create a shader from vertex program source code
-    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vs, 1, &source_vp, NULL);
-    glCompileShader(vs);
+    std::string source = LoadTextFile(path);
+
+    // The defines go on the lines after #version, which has to come first
+    if (!defines.empty()) {
+        std::string define_lines;
+        for (int i = 0; i < defines.size(); i++) {
+            define_lines += "#define " + defines[i] + "\n";
+        }
+        size_t insert_at = 0;
+        size_t version = source.find("#version");
+        if (version != std::string::npos) {
+            size_t line_end = source.find('\n', version);
+            if (line_end == std::string::npos) {
+                source += '\n';
+                line_end = source.size() - 1;
+            }
+            insert_at = line_end + 1;
+        }
+        source.insert(insert_at, define_lines);
+    }
+    const char *source_c = source.c_str();
+
+    // Create a shader from the source code
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source_c, NULL);
+    glCompileShader(shader);
 
     // Check if shader compiled successfully
     GLint status;
-    glGetShaderiv(vs, GL_COMPILE_STATUS, &status);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
     if (status != GL_TRUE) {
         char buffer[512];
-        glGetShaderInfoLog(vs, 512, NULL, buffer);
-        throw(std::ios_base::failure(std::string("Error compiling vertex shader: ") + std::string(buffer)));
+        glGetShaderInfoLog(shader, 512, NULL, buffer);
+        std::string stage = (type == GL_VERTEX_SHADER) ? "vertex" : "fragment";
+        throw(std::ios_base::failure(std::string("Error compiling ") + stage + std::string(" shader ") + std::string(path) + std::string(": ") + std::string(buffer)));
     }
 
-    // Create a shader from the fragment program source code
-    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fs, 1, &source_fp, NULL);
-    glCompileShader(fs);
+    return shader;
+}
 
-    // Check if shader compiled successfully
-    glGetShaderiv(fs, GL_COMPILE_STATUS, &status);
-    if (status != GL_TRUE) {
-        char buffer[512];
-        glGetShaderInfoLog(fs, 512, NULL, buffer);
-        throw(std::ios_base::failure(std::string("Error compiling fragment shader: ") + std::string(buffer)));
-    }
 
-    // Create a shader program linking both vertex and fragment shaders
-    // together
-    shader_program_ = glCreateProgram();
-    glAttachShader(shader_program_, vs);
-    glAttachShader(shader_program_, fs);
+void Shader::Link(void)
+{
+
+    // Keep the vertex position at location 0, some compatibility profile drivers skip draws where attribute 0 is not an array,
+    // which a per-object transform set as a constant is not
+    glBindAttribLocation(shader_program_, 0, "vertex");
     glLinkProgram(shader_program_);
 
     // Check if shaders were linked successfully
+    GLint status;
     glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
     if (status != GL_TRUE) {
         char buffer[512];
-        glGetShaderInfoLog(shader_program_, 512, NULL, buffer);
+        glGetProgramInfoLog(shader_program_, 512, NULL, buffer);
         throw(std::ios_base::failure(std::string("Error linking shaders: ") + std::string(buffer)));
     }
-
-    // Delete memory used by shaders, since they were already compiled
-    // and linked
-    glDeleteShader(vs);
-    glDeleteShader(fs);
 }
 
 
 void Shader::SetUniform1i(const GLchar *name, int value)
 {
 
+    GLStats::CountUniform();
     glUniform1i(glGetUniformLocation(shader_program_, name), value);
 }
 
@@ -86,6 +145,7 @@ void Shader::SetUniform1i(const GLchar *name, int value)
 void Shader::SetUniform1f(const GLchar *name, float value)
 {
 
+    GLStats::CountUniform();
     glUniform1f(glGetUniformLocation(shader_program_, name), value);
 }
 
@@ -93,6 +153,7 @@ void Shader::SetUniform1f(const GLchar *name, float value)
 void Shader::SetUniform2f(const GLchar *name, const glm::vec2 &vector)
 {
 
+    GLStats::CountUniform();
     glUniform2f(glGetUniformLocation(shader_program_, name), vector.x, vector.y);
 }
 
@@ -100,6 +161,7 @@ void Shader::SetUniform2f(const GLchar *name, const glm::vec2 &vector)
 void Shader::SetUniform3f(const GLchar *name, const glm::vec3 &vector)
 {
 
+    GLStats::CountUniform();
     glUniform3f(glGetUniformLocation(shader_program_, name), vector.x, vector.y, vector.z);
 }
 
@@ -107,6 +169,7 @@ void Shader::SetUniform3f(const GLchar *name, const glm::vec3 &vector)
 void Shader::SetUniform4f(const GLchar *name, const glm::vec4 &vector)
 {
 
+    GLStats::CountUniform();
     glUniform4f(glGetUniformLocation(shader_program_, name), vector.x, vector.y, vector.z, vector.w);
 }
 
@@ -114,34 +177,90 @@ void Shader::SetUniform4f(const GLchar *name, const glm::vec4 &vector)
 void Shader::SetUniformMat4(const GLchar *name, const glm::mat4 &matrix)
 {
 
+    GLStats::CountUniform();
     glUniformMatrix4fv(glGetUniformLocation(shader_program_, name), 1, GL_FALSE, glm::value_ptr(matrix));
 }
 
 void Shader::SetUniformIntArray(const GLchar *name, int len, const GLint *data)
 {
 
+    GLStats::CountUniform();
     glUniform1iv(glGetUniformLocation(shader_program_, name), len, data);
 }
 
 
+void Shader::BindUniformBlock(const GLchar *name, GLuint binding)
+{
+
+    GLuint index = glGetUniformBlockIndex(shader_program_, name);
+    if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(shader_program_, index, binding);
+    }
+}
+
+
+void Shader::SetTransformStream(TransformStream *transforms)
+{
+
+    transforms_ = transforms;
+}
+
+
+void Shader::SetTransform(const Transform2D &transform)
+{
+
+    if (transform_location_ < 0) {
+        return;
+    }
+
+    // without a VAO the locations can still have an array enabled by another program's attributes, which would be read instead
+    GLStats::CountUniform();
+    glDisableVertexAttribArray(transform_location_);
+    glDisableVertexAttribArray(transform_location_ + 1);
+    glVertexAttrib4fv(transform_location_, glm::value_ptr(transform.row_x));
+    glVertexAttrib4fv(transform_location_ + 1, glm::value_ptr(transform.row_y));
+}
+
+
+bool Shader::SetInstanceTransforms(const Transform2D *transforms, int count)
+{
+
+    if (transform_location_ < 0 || transforms_ == nullptr) {
+        return false;
+    }
+
+    GLStats::CountUniform();
+    return transforms_->Bind(transform_location_, transforms, count);
+}
+
+
+void Shader::ResetTransform(void)
+{
+
+    if (transform_location_ >= 0 && transforms_ != nullptr) {
+        transforms_->Unbind(transform_location_);
+    }
+}
+
+
 Shader::~Shader() 
 {
 
-    glDeleteProgram(shader_program_);
+    GLState::DeleteProgram(shader_program_);
 }
 
 
 void Shader::Enable() 
 {
 
-    glUseProgram(shader_program_);
+    GLState::UseProgram(shader_program_);
 }
 
 
 void Shader::Disable()
 {
 
-    glUseProgram(0);
+    GLState::UseProgram(0);
 }
 
 } // namespace game
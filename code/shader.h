@@ -3,8 +3,12 @@
 
 #define GLEW_STATIC
 #include <GL/glew.h>
+#include <string>
+#include <vector>
 #include <glm/glm.hpp>
 
+#include "transform_stream.h"
+
 namespace game {
 
     // A class that stores a pair of vertex, fragment shaders
@@ -17,6 +21,16 @@ namespace game {
             // Initialize shader with source files
             void Init(const char *vertPath, const char *fragPath);
 
+            // Initialize a vertex-only shader whose outputs are captured with transform feedback, interleaved in the given order
+            void InitFeedback(const char *vertPath, const std::vector<const char *> &varyings);
+
+            // Initialize from stages already compiled, which stay owned by the caller
+            void Init(GLuint vertex_shader, GLuint fragment_shader);
+            void InitFeedback(GLuint vertex_shader, const std::vector<const char *> &varyings);
+
+            // Compile one stage with a #define line for each name after #version, throwing with the info log on failure
+            static GLuint Compile(GLenum type, const char *path, const std::vector<std::string> &defines = {});
+
             // Enable or disable this specific shader
             void Enable();
             void Disable();
@@ -42,13 +56,35 @@ namespace game {
             // Sets a uniform array of integers
             void SetUniformIntArray(const GLchar *name, int len, const GLint *data);
 
+            // Points a uniform block at a buffer binding point, if the shader declares it
+            void BindUniformBlock(const GLchar *name, GLuint binding);
+
+            // Instanced draws read their transforms from the stream, see SetInstanceTransforms
+            void SetTransformStream(TransformStream *transforms);
+
+            // Sets the transformation attribute as a constant, for the draws of a single object that follow
+            void SetTransform(const Transform2D &transform);
+
+            // Streams one transformation per instance for the next instanced draw, false when there is no stream or it is full
+            bool SetInstanceTransforms(const Transform2D *transforms, int count);
+
+            // Call after the instanced draw, so the next draws with other shaders do not read the stream
+            void ResetTransform(void);
+
             // Get OpenGL reference of shader program
             inline GLuint GetShaderProgram(void) const { return shader_program_; }
 
         private:
+            // Link the attached stages, throwing with the info log on failure
+            void Link(void);
+
             // Reference to shader program
             GLuint shader_program_;
 
+            // Per-object transforms
+            TransformStream *transforms_;
+            GLint transform_location_;
+
     }; // class Shader
 } // namespace game
 
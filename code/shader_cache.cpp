@@ -0,0 +1,95 @@
+#include <algorithm>
+
+#include "shader_cache.h"
+
+namespace game {
+
+    ShaderCache::ShaderCache(void) {}
+
+
+    ShaderCache::~ShaderCache()
+    {
+        for (auto& program : programs_) {
+            delete program.second;
+        }
+        for (auto& stage : stages_) {
+            glDeleteShader(stage.second);
+        }
+    }
+
+
+    void ShaderCache::Init(const std::string& directory, CameraBuffer* camera, TransformStream* transforms)
+    {
+        directory_ = directory;
+        camera_ = camera;
+        transforms_ = transforms;
+    }
+
+
+    std::string ShaderCache::MakeKey(const std::string& file, std::vector<std::string> defines)
+    {
+        std::sort(defines.begin(), defines.end());
+        std::string key = file;
+        for (int i = 0; i < defines.size(); i++) {
+            key += " " + defines[i];
+        }
+        return key;
+    }
+
+
+    GLuint ShaderCache::GetStage(GLenum type, const std::string& file, const std::vector<std::string>& defines)
+    {
+        std::string key = MakeKey(file, defines);
+        auto found = stages_.find(key);
+        if (found != stages_.end()) {
+            return found->second;
+        }
+
+        GLuint stage = Shader::Compile(type, (directory_ + file).c_str(), defines);
+        stages_[key] = stage;
+        return stage;
+    }
+
+
+    Shader* ShaderCache::Add(const std::string& key, Shader* shader)
+    {
+        if (camera_ != nullptr) {
+            camera_->Attach(shader);
+        }
+        shader->SetTransformStream(transforms_);
+        programs_[key] = shader;
+        return shader;
+    }
+
+
+    Shader* ShaderCache::Get(const std::string& vertex_file, const std::string& fragment_file, const std::vector<std::string>& defines)
+    {
+        std::string key = MakeKey(vertex_file + " " + fragment_file, defines);
+        auto found = programs_.find(key);
+        if (found != programs_.end()) {
+            return found->second;
+        }
+
+        Shader* shader = new Shader();
+        shader->Init(GetStage(GL_VERTEX_SHADER, vertex_file, defines), GetStage(GL_FRAGMENT_SHADER, fragment_file, defines));
+        return Add(key, shader);
+    }
+
+
+    Shader* ShaderCache::GetFeedback(const std::string& vertex_file, const std::vector<const char*>& varyings, const std::vector<std::string>& defines)
+    {
+        std::string key = MakeKey(vertex_file, defines);
+        for (int i = 0; i < varyings.size(); i++) {
+            key += std::string(i == 0 ? " -> " : ",") + varyings[i];
+        }
+        auto found = programs_.find(key);
+        if (found != programs_.end()) {
+            return found->second;
+        }
+
+        Shader* shader = new Shader();
+        shader->InitFeedback(GetStage(GL_VERTEX_SHADER, vertex_file, defines), varyings);
+        return Add(key, shader);
+    }
+
+} // namespace game
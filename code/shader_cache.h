@@ -0,0 +1,62 @@
+#ifndef SHADER_CACHE_H_
+#define SHADER_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+#include "camera_buffer.h"
+#include "shader.h"
+#include "transform_stream.h"
+
+namespace game {
+
+    /*
+        ShaderCache builds shader program variants from a pair of source files and a set of #define names,
+        and keeps each one under that key, so asking for the same variant twice returns the same program
+        Objects pick their variant once as they are set up, instead of setting a uniform the shader branches on before every draw
+        Compiled stages are kept as well, a source shared by several programs compiles once per set of defines
+        Every program it builds shares the camera block and the transform stream it was given
+    */
+    class ShaderCache {
+
+    public:
+        ShaderCache(void);
+        ~ShaderCache();
+
+        // Call once there is an OpenGL context, source files are looked up in directory
+        void Init(const std::string& directory, CameraBuffer* camera, TransformStream* transforms);
+
+        // The variant of a vertex and fragment shader with these defines, built on first use
+        Shader* Get(const std::string& vertex_file, const std::string& fragment_file, const std::vector<std::string>& defines = {});
+
+        // The variant of a vertex-only shader captured with transform feedback, built on first use
+        Shader* GetFeedback(const std::string& vertex_file, const std::vector<const char*>& varyings, const std::vector<std::string>& defines = {});
+
+        inline int getProgramCount(void) const { return static_cast<int>(programs_.size()); };
+        inline int getStageCount(void) const { return static_cast<int>(stages_.size()); };
+
+    private:
+        // The stage compiled from file with these defines, compiled on first use
+        GLuint GetStage(GLenum type, const std::string& file, const std::vector<std::string>& defines);
+
+        // Sets up a new program and stores it under key
+        Shader* Add(const std::string& key, Shader* shader);
+
+        // file followed by the sorted defines, so their order does not make a new variant
+        static std::string MakeKey(const std::string& file, std::vector<std::string> defines);
+
+        std::string directory_;
+        CameraBuffer* camera_ = nullptr;
+        TransformStream* transforms_ = nullptr;
+
+        std::map<std::string, Shader*> programs_;
+        std::map<std::string, GLuint> stages_;
+
+    }; // class ShaderCache
+
+} // namespace game
+
+#endif // SHADER_CACHE_H_
@@ -0,0 +1,168 @@
+#ifndef SIMD_H_
+#define SIMD_H_
+
+// Thin wrappers around the SIMD instruction sets, so batched kernels can be
+// written once and compiled for AVX (8 lanes), SSE2 (4 lanes) or plain scalar code
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SIMD_AVX 1
+#define SIMD_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_SSE 1
+#define SIMD_WIDTH 4
+#else
+#include <cmath>
+#define SIMD_WIDTH 1
+#endif
+
+namespace game {
+
+    namespace simd {
+
+        // rounds a lane count up to a whole number of SIMD registers
+        inline int padded(int count) { return (count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH; }
+
+#if defined(SIMD_AVX)
+        typedef __m256 vfloat;
+        typedef __m256 vmask;
+
+        inline vfloat load(const float* p) { return _mm256_loadu_ps(p); }
+        inline void store(float* p, vfloat a) { _mm256_storeu_ps(p, a); }
+        inline vfloat set1(float a) { return _mm256_set1_ps(a); }
+        inline vfloat add(vfloat a, vfloat b) { return _mm256_add_ps(a, b); }
+        inline vfloat sub(vfloat a, vfloat b) { return _mm256_sub_ps(a, b); }
+        inline vfloat mul(vfloat a, vfloat b) { return _mm256_mul_ps(a, b); }
+        inline vfloat div(vfloat a, vfloat b) { return _mm256_div_ps(a, b); }
+        inline vfloat min(vfloat a, vfloat b) { return _mm256_min_ps(a, b); }
+        inline vfloat max(vfloat a, vfloat b) { return _mm256_max_ps(a, b); }
+        inline vfloat sqrt(vfloat a) { return _mm256_sqrt_ps(a); }
+        inline vfloat floor(vfloat a) { return _mm256_floor_ps(a); }
+        inline vfloat abs(vfloat a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+        inline vfloat negate(vfloat a) { return _mm256_xor_ps(_mm256_set1_ps(-0.0f), a); }
+        inline vmask lt(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        inline vmask gt(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        inline vmask ge(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        inline vmask le(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+        inline vmask mask_and(vmask a, vmask b) { return _mm256_and_ps(a, b); }
+        inline vmask mask_or(vmask a, vmask b) { return _mm256_or_ps(a, b); }
+        inline bool any(vmask a) { return _mm256_movemask_ps(a) != 0; }
+        // picks a where the mask is set, b otherwise
+        inline vfloat select(vmask m, vfloat a, vfloat b) { return _mm256_blendv_ps(b, a, m); }
+
+#elif defined(SIMD_SSE)
+        typedef __m128 vfloat;
+        typedef __m128 vmask;
+
+        inline vfloat load(const float* p) { return _mm_loadu_ps(p); }
+        inline void store(float* p, vfloat a) { _mm_storeu_ps(p, a); }
+        inline vfloat set1(float a) { return _mm_set1_ps(a); }
+        inline vfloat add(vfloat a, vfloat b) { return _mm_add_ps(a, b); }
+        inline vfloat sub(vfloat a, vfloat b) { return _mm_sub_ps(a, b); }
+        inline vfloat mul(vfloat a, vfloat b) { return _mm_mul_ps(a, b); }
+        inline vfloat div(vfloat a, vfloat b) { return _mm_div_ps(a, b); }
+        inline vfloat min(vfloat a, vfloat b) { return _mm_min_ps(a, b); }
+        inline vfloat max(vfloat a, vfloat b) { return _mm_max_ps(a, b); }
+        inline vfloat sqrt(vfloat a) { return _mm_sqrt_ps(a); }
+        inline vfloat abs(vfloat a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+        inline vfloat negate(vfloat a) { return _mm_xor_ps(_mm_set1_ps(-0.0f), a); }
+        inline vmask lt(vfloat a, vfloat b) { return _mm_cmplt_ps(a, b); }
+        inline vmask gt(vfloat a, vfloat b) { return _mm_cmpgt_ps(a, b); }
+        inline vmask ge(vfloat a, vfloat b) { return _mm_cmpge_ps(a, b); }
+        inline vmask le(vfloat a, vfloat b) { return _mm_cmple_ps(a, b); }
+        inline vmask mask_and(vmask a, vmask b) { return _mm_and_ps(a, b); }
+        inline vmask mask_or(vmask a, vmask b) { return _mm_or_ps(a, b); }
+        inline bool any(vmask a) { return _mm_movemask_ps(a) != 0; }
+        inline vfloat select(vmask m, vfloat a, vfloat b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+        // SSE2 has no floor instruction: truncate, then step down for negative fractions
+        inline vfloat floor(vfloat a) {
+            vfloat t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+            return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.0f)));
+        }
+
+#else
+        typedef float vfloat;
+        typedef bool vmask;
+
+        inline vfloat load(const float* p) { return *p; }
+        inline void store(float* p, vfloat a) { *p = a; }
+        inline vfloat set1(float a) { return a; }
+        inline vfloat add(vfloat a, vfloat b) { return a + b; }
+        inline vfloat sub(vfloat a, vfloat b) { return a - b; }
+        inline vfloat mul(vfloat a, vfloat b) { return a * b; }
+        inline vfloat div(vfloat a, vfloat b) { return a / b; }
+        inline vfloat min(vfloat a, vfloat b) { return a < b ? a : b; }
+        inline vfloat max(vfloat a, vfloat b) { return a > b ? a : b; }
+        inline vfloat sqrt(vfloat a) { return std::sqrt(a); }
+        inline vfloat floor(vfloat a) { return std::floor(a); }
+        inline vfloat abs(vfloat a) { return std::fabs(a); }
+        inline vfloat negate(vfloat a) { return -a; }
+        inline vmask lt(vfloat a, vfloat b) { return a < b; }
+        inline vmask gt(vfloat a, vfloat b) { return a > b; }
+        inline vmask ge(vfloat a, vfloat b) { return a >= b; }
+        inline vmask le(vfloat a, vfloat b) { return a <= b; }
+        inline vmask mask_and(vmask a, vmask b) { return a && b; }
+        inline vmask mask_or(vmask a, vmask b) { return a || b; }
+        inline bool any(vmask a) { return a; }
+        inline vfloat select(vmask m, vfloat a, vfloat b) { return m ? a : b; }
+#endif
+
+        // Approximations of the libm functions the game uses, branch free so every lane runs the same code
+
+        // atan2, max error around 1e-5 rad
+        inline vfloat atan2(vfloat y, vfloat x) {
+            vfloat ax = abs(x);
+            vfloat ay = abs(y);
+            vfloat a = div(min(ax, ay), max(max(ax, ay), set1(1e-30f)));
+            vfloat s = mul(a, a);
+            vfloat r = add(mul(set1(-0.0464964749f), s), set1(0.15931422f));
+            r = sub(mul(r, s), set1(0.327622764f));
+            r = add(mul(mul(r, s), a), a);
+            r = select(gt(ay, ax), sub(set1(1.57079637f), r), r);
+            r = select(lt(x, set1(0.0f)), sub(set1(3.14159274f), r), r);
+            return select(lt(y, set1(0.0f)), negate(r), r);
+        }
+
+        // sin and cos of the same angle, max error around 1e-6
+        inline void sincos(vfloat angle, vfloat* out_sin, vfloat* out_cos) {
+            // reduce to [-pi, pi]
+            vfloat turns = floor(add(mul(angle, set1(0.159154943f)), set1(0.5f)));
+            vfloat x = sub(angle, mul(turns, set1(6.28318531f)));
+
+            // reflect into [-pi/2, pi/2], where the polynomials are accurate
+            vfloat half_pi = set1(1.57079637f);
+            vmask upper = gt(x, half_pi);
+            vmask lower = lt(x, negate(half_pi));
+            x = select(upper, sub(set1(3.14159274f), x), x);
+            x = select(lower, sub(set1(-3.14159274f), x), x);
+            vfloat cos_sign = select(mask_or(upper, lower), set1(-1.0f), set1(1.0f));
+
+            vfloat x2 = mul(x, x);
+            vfloat s = add(mul(set1(-2.50521084e-8f), x2), set1(2.75573192e-6f));
+            s = add(mul(s, x2), set1(-1.98412698e-4f));
+            s = add(mul(s, x2), set1(8.33333333e-3f));
+            s = add(mul(s, x2), set1(-1.66666667e-1f));
+            s = add(mul(mul(s, x2), x), x);
+
+            vfloat c = add(mul(set1(2.08767570e-9f), x2), set1(-2.75573192e-7f));
+            c = add(mul(c, x2), set1(2.48015873e-5f));
+            c = add(mul(c, x2), set1(-1.38888889e-3f));
+            c = add(mul(c, x2), set1(4.16666667e-2f));
+            c = add(mul(c, x2), set1(-0.5f));
+            c = add(mul(c, x2), set1(1.0f));
+
+            *out_sin = s;
+            *out_cos = mul(c, cos_sign);
+        }
+
+        // wraps an angle into [0, 2pi)
+        inline vfloat wrap_positive(vfloat angle) {
+            vfloat two_pi = set1(6.28318531f);
+            return sub(angle, mul(floor(div(angle, two_pi)), two_pi));
+        }
+
+    } // namespace simd
+
+} // namespace game
+
+#endif // SIMD_H_
@@ -1,6 +1,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "text_game_object.h"
+#include "gl_state.h"
+#include "gl_stats.h"
 
 namespace game {
 
@@ -9,37 +11,28 @@ TextGameObject::TextGameObject(const glm::vec3 &position, Geometry *geom, Shader
     text_ = "";
     offset_ = glm::vec2(0.0, 0.0);
     origin_ = nullptr;
+    needs_update = false;
 }
 
 
-void TextGameObject::Render(glm::mat4 view_matrix, double current_time) {
+void TextGameObject::Render(double current_time) {
+    GL_STATS_SCOPE("TextGameObject::Render");
 
     // Set up the shader
     shader_->Enable();
 
-    // Set up the view matrix
-    shader_->SetUniformMat4("view_matrix", view_matrix);
 
-    // Setup the scaling matrix for the shader
-    glm::mat4 scaling_matrix = glm::scale(glm::mat4(1.0f), glm::vec3(scale_.x, scale_.y, 1.0));
+    // Setup the transformation for the shader, scaled, then rotated, then translated
+    Transform2D transformation = Transform2D::Make(position_, angle_, scale_);
 
-    // Setup the rotation matrix for the shader
-    glm::mat4 rotation_matrix = glm::rotate(glm::mat4(1.0f), angle_, glm::vec3(0.0, 0.0, 1.0));
-
-    // Set up the translation matrix for the shader
-    glm::mat4 translation_matrix = glm::translate(glm::mat4(1.0f), position_);
-
-    // Setup the transformation matrix for the shader
-    glm::mat4 transformation_matrix = translation_matrix * rotation_matrix * scaling_matrix;
-
-    // Set the transformation matrix in the shader
-    shader_->SetUniformMat4("transformation_matrix", transformation_matrix);
+    // Set the transformation in the shader
+    shader_->SetTransform(transformation);
 
     // Set up the geometry
     geometry_->SetGeometry(shader_->GetShaderProgram());
 
     // Bind the entity's texture
-    glBindTexture(GL_TEXTURE_2D, texture_);
+    GLState::BindTexture(texture_);
 
     // Set the text
 #define TEXT_LENGTH 40
@@ -58,7 +51,7 @@ void TextGameObject::Render(glm::mat4 view_matrix, double current_time) {
     shader_->SetUniformIntArray("text_content", final_size, data);
 
     // Draw the entity
-    glDrawElements(GL_TRIANGLES, geometry_->GetSize(), GL_UNSIGNED_INT, 0);
+    GLStats::DrawElements(GL_TRIANGLES, geometry_->GetSize(), GL_UNSIGNED_INT, 0);
 }
 
 
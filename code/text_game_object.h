@@ -25,11 +25,12 @@ namespace game {
             {
                 offset_ = offset;
                 origin_ = origin;
+                needs_update = origin_ != nullptr;
             }
             void SetVisible(bool visible) { visible_ = visible; }
 
             // Render function for the text
-            void Render(glm::mat4 view_matrix, double current_time) override;
+            void Render(double current_time) override;
 
             // Update function for the text
             void Update(double delta_time) override;
@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <SOIL/SOIL.h>
+
+#include "texture_loader.h"
+#include "gl_state.h"
+
+namespace game {
+
+    std::vector<TextureMemory> TextureLoader::memory_;
+    std::vector<TextureLoader::LoadedTexture> TextureLoader::loaded_;
+
+
+    int TextureLoader::DroppedLevels(int width, int height, float screen_size)
+    {
+        // stop at the last level still at least as large as it is drawn
+        int levels = 0;
+        int size = std::max(width, height);
+        while (size > 1 && size / 2 >= screen_size) {
+            size /= 2;
+            levels++;
+        }
+        return levels;
+    }
+
+
+    unsigned char* TextureLoader::Halve(unsigned char* image, int* width, int* height)
+    {
+        int half_width = std::max(*width / 2, 1);
+        int half_height = std::max(*height / 2, 1);
+        unsigned char* half = new unsigned char[half_width * half_height * 4];
+
+        for (int y = 0; y < half_height; y++) {
+            int y0 = std::min(y * 2, *height - 1);
+            int y1 = std::min(y * 2 + 1, *height - 1);
+            for (int x = 0; x < half_width; x++) {
+                int x0 = std::min(x * 2, *width - 1);
+                int x1 = std::min(x * 2 + 1, *width - 1);
+                for (int c = 0; c < 4; c++) {
+                    int sum = image[(y0 * *width + x0) * 4 + c] + image[(y0 * *width + x1) * 4 + c]
+                        + image[(y1 * *width + x0) * 4 + c] + image[(y1 * *width + x1) * 4 + c];
+                    half[(y * half_width + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+                }
+            }
+        }
+
+        *width = half_width;
+        *height = half_height;
+        return half;
+    }
+
+
+    GLenum TextureLoader::InternalFormat(TextureFormat format, const char** name)
+    {
+        bool s3tc = GLEW_EXT_texture_compression_s3tc;
+        bool swizzle = GLEW_VERSION_3_3 || GLEW_ARB_texture_swizzle;
+        switch (format) {
+        case TextureFormat::RGBA4:
+            *name = "RGBA4";
+            return GL_RGBA4;
+        case TextureFormat::RGB5_A1:
+            *name = "RGB5_A1";
+            return GL_RGB5_A1;
+        case TextureFormat::LUMINANCE:
+            // red only, swizzled back to grey in Load; the legacy luminance format reads the same where swizzles are missing
+            *name = swizzle ? "R8" : "LUMINANCE8";
+            return swizzle ? GL_R8 : GL_LUMINANCE8;
+        case TextureFormat::COMPRESSED_RGB:
+            // opaque, so one bit of alpha loses nothing
+            *name = s3tc ? "DXT1" : "RGB5_A1";
+            return s3tc ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_RGB5_A1;
+        case TextureFormat::COMPRESSED_RGBA:
+            // soft edges over many colours band in four bits, keep eight
+            *name = s3tc ? "DXT5" : "RGBA8";
+            return s3tc ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_RGBA8;
+        default:
+            *name = "RGBA8";
+            return GL_RGBA8;
+        }
+    }
+
+
+    void TextureLoader::MeasureMemory(int* bytes, int* rgba8_bytes)
+    {
+        *bytes = 0;
+        *rgba8_bytes = 0;
+        for (int level = 0; ; level++) {
+            GLint width = 0, height = 0;
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &width);
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_HEIGHT, &height);
+            if (width == 0 || height == 0) {
+                break;
+            }
+            *rgba8_bytes += width * height * 4;
+
+            // what the driver stores, which can be larger than the format asked for
+            GLint compressed = GL_FALSE;
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED, &compressed);
+            if (compressed) {
+                GLint size = 0;
+                glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+                *bytes += size;
+            } else {
+                GLint bits = 0;
+                const GLenum channels[] = { GL_TEXTURE_RED_SIZE, GL_TEXTURE_GREEN_SIZE, GL_TEXTURE_BLUE_SIZE, GL_TEXTURE_ALPHA_SIZE, GL_TEXTURE_LUMINANCE_SIZE };
+                for (GLenum channel : channels) {
+                    GLint size = 0;
+                    glGetTexLevelParameteriv(GL_TEXTURE_2D, level, channel, &size);
+                    bits += size;
+                }
+                *bytes += (width * height * bits + 7) / 8;
+            }
+            if (width == 1 && height == 1) {
+                break;
+            }
+        }
+    }
+
+
+    void TextureLoader::Load(GLuint texture, const char* file, float screen_size, bool mipmaps, TextureFormat format, GLenum wrap)
+    {
+        LoadedTexture loaded = { texture, file, screen_size, mipmaps, format, wrap, 0, 0 };
+        TextureMemory memory;
+        if (!Upload(&loaded, &memory)) {
+            return;
+        }
+        loaded_.push_back(loaded);
+        memory_.push_back(memory);
+    }
+
+
+    void TextureLoader::Rescale(float scale)
+    {
+        for (int i = 0; i < loaded_.size(); i++) {
+            LoadedTexture& loaded = loaded_[i];
+            loaded.screen_size *= scale;
+
+            // the level kept is still at least as large as the texture is drawn, or already the whole image
+            if (loaded.resident_size >= loaded.screen_size || loaded.resident_size == loaded.image_size) {
+                continue;
+            }
+            Upload(&loaded, &memory_[i]);
+        }
+    }
+
+
+    bool TextureLoader::Upload(LoadedTexture* loaded, TextureMemory* memory)
+    {
+        GLState::BindTexture(loaded->texture);
+
+        int width, height;
+        unsigned char* image = SOIL_load_image(loaded->file.c_str(), &width, &height, 0, SOIL_LOAD_RGBA);
+        if (!image) {
+            std::cout << "Cannot load texture " << loaded->file << std::endl;
+            return false;
+        }
+        loaded->image_size = std::max(width, height);
+
+        // drop the levels that are never sampled, the first one kept becomes level 0
+        int dropped = DroppedLevels(width, height, loaded->screen_size);
+        unsigned char* resident = image;
+        for (int i = 0; i < dropped; i++) {
+            unsigned char* half = Halve(resident, &width, &height);
+            if (resident != image) {
+                delete[] resident;
+            }
+            resident = half;
+        }
+        loaded->resident_size = std::max(width, height);
+
+        // the driver converts, and for the compressed formats encodes, the RGBA image as it uploads it
+        const char* format_name;
+        GLenum internal_format = InternalFormat(loaded->format, &format_name);
+        glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, resident);
+        if (internal_format == GL_R8) {
+            const GLint grey[] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, grey);
+        }
+        if (resident != image) {
+            delete[] resident;
+        }
+        SOIL_free_image_data(image);
+
+        // Texture Wrapping
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, loaded->wrap);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, loaded->wrap);
+
+        // Texture Filtering
+        if (loaded->mipmaps) {
+            glGenerateMipmap(GL_TEXTURE_2D);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+        } else {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        memory->file = loaded->file;
+        memory->format = format_name;
+        MeasureMemory(&memory->bytes, &memory->rgba8_bytes);
+        return true;
+    }
+
+
+    void TextureLoader::DumpMemory(std::ostream& out)
+    {
+        auto row = [&out](const std::string& name, const char* format, int bytes, int rgba8_bytes) {
+            out << "  " << std::left << std::setw(40) << name << std::setw(12) << format << std::right
+                << std::setw(10) << bytes / 1024 << std::setw(10) << rgba8_bytes / 1024 << std::setw(10) << (rgba8_bytes - bytes) / 1024 << std::endl;
+        };
+
+        out << "  " << std::left << std::setw(40) << "Texture memory, KB" << std::setw(12) << "format" << std::right
+            << std::setw(10) << "stored" << std::setw(10) << "rgba8" << std::setw(10) << "saved" << std::endl;
+        int total = 0;
+        int rgba8_total = 0;
+        for (int i = 0; i < memory_.size(); i++) {
+            const TextureMemory& memory = memory_[i];
+            std::string name = memory.file.substr(memory.file.find_last_of("/\\") + 1);
+            row(name, memory.format, memory.bytes, memory.rgba8_bytes);
+            total += memory.bytes;
+            rgba8_total += memory.rgba8_bytes;
+        }
+        row("total", "", total, rgba8_total);
+    }
+
+} // namespace game
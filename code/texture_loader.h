@@ -0,0 +1,82 @@
+#ifndef TEXTURE_LOADER_H_
+#define TEXTURE_LOADER_H_
+
+#include <ostream>
+#include <string>
+#include <vector>
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+#include "config.h"
+
+namespace game {
+
+    // Memory a loaded texture takes, over all its levels, and what the same levels would take as RGBA8
+    struct TextureMemory {
+        std::string file;
+        const char* format;
+        int bytes;
+        int rgba8_bytes;
+    };
+
+    /*
+        TextureLoader uploads image files into textures with only the mip levels they are drawn at
+        Levels larger than the texture ever covers on screen are never sampled, so they are halved away on the cpu
+        before the upload, and the rest of the chain is generated by OpenGL; the nearest level is filtered linearly,
+        blending two levels costs too much where filtering runs in software
+        When the window grows, Rescale loads the textures that now need a level they dropped again
+        Each texture is stored in the internal format its asset asks for, or the nearest one the driver supports,
+        and the memory it ends up taking is read back from OpenGL
+    */
+    class TextureLoader {
+
+    public:
+        // Loads file into texture, which is bound, keeping only the levels needed to draw it at most screen_size pixels across
+        // Without mipmaps only the first kept level is uploaded and filtered linearly, for atlases whose lookups jump between cells
+        static void Load(GLuint texture, const char* file, float screen_size, bool mipmaps, TextureFormat format = TextureFormat::RGBA8, GLenum wrap = GL_CLAMP_TO_EDGE);
+
+        // Every texture is now drawn scale times as large, loads again the ones whose kept levels are too small for it
+        static void Rescale(float scale);
+
+        // Number of top levels of a width by height image that are larger than screen_size pixels needs
+        static int DroppedLevels(int width, int height, float screen_size);
+
+        // Every texture loaded so far
+        inline static const std::vector<TextureMemory>& getMemory(void) { return memory_; };
+
+        // Writes the memory of every texture loaded so far as a table, with the totals
+        static void DumpMemory(std::ostream& out);
+
+    private:
+        // What a texture was loaded with, to load it again, and the largest side of the image and of the level it kept
+        struct LoadedTexture {
+            GLuint texture;
+            std::string file;
+            float screen_size;
+            bool mipmaps;
+            TextureFormat format;
+            GLenum wrap;
+            int image_size;
+            int resident_size;
+        };
+
+        // Uploads the levels of loaded's file that its screen_size needs, false if the file does not load
+        static bool Upload(LoadedTexture* loaded, TextureMemory* memory);
+
+        // Replaces the RGBA image with one half its size each way, averaging each 2x2 block
+        static unsigned char* Halve(unsigned char* image, int* width, int* height);
+
+        // Internal format for format, or a fallback when the driver lacks what it needs, and its name
+        static GLenum InternalFormat(TextureFormat format, const char** name);
+
+        // Bytes the levels of the bound texture take, and would take as RGBA8
+        static void MeasureMemory(int* bytes, int* rgba8_bytes);
+
+        static std::vector<TextureMemory> memory_;
+        static std::vector<LoadedTexture> loaded_;     // in the same order as memory_
+
+    }; // class TextureLoader
+
+} // namespace game
+
+#endif // TEXTURE_LOADER_H_
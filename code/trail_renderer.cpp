@@ -0,0 +1,45 @@
+#include "trail_renderer.h"
+#include "gl_stats.h"
+
+namespace game {
+
+    TrailRenderer::TrailRenderer(void)
+    {
+        for (int i = 0; i < BULLET_TYPE_COUNT; i++) {
+            budgets_[i] = BULLET_TRAIL_BUDGET;
+            counts_[i] = 0;
+        }
+    }
+
+
+    void TrailRenderer::Init(ParticleSystem* trail, Shader* instanced_shader)
+    {
+        batch_.Init(trail->getGeometry(), instanced_shader, trail->getTexture());
+        cycle_ = trail->getCycle();
+        speed_ = trail->getSpeed();
+    }
+
+
+    void TrailRenderer::add(BulletType type, glm::vec3 position, float rotation, float scale, double start_time)
+    {
+        int& count = counts_[static_cast<int>(type)];
+        if (count >= budgets_[static_cast<int>(type)]) {
+            return;
+        }
+        count++;
+
+        batch_.add({ position.x, position.y, rotation, scale, static_cast<float>(start_time), cycle_, speed_ });
+    }
+
+
+    void TrailRenderer::Render(double current_time)
+    {
+        GL_STATS_SCOPE("TrailRenderer::Render");
+        batch_.Render(current_time);
+
+        for (int i = 0; i < BULLET_TYPE_COUNT; i++) {
+            counts_[i] = 0;
+        }
+    }
+
+} // namespace game
@@ -0,0 +1,51 @@
+#ifndef TRAIL_RENDERER_H_
+#define TRAIL_RENDERER_H_
+
+#include <glm/glm.hpp>
+
+#include "config.h"
+#include "particle_batch.h"
+#include "particle_system.h"
+
+namespace game {
+
+    /*
+        TrailRenderer draws the trails of every live bullet in one instanced call
+        Bullets only keep a pointer to it, their trail scale and the time they were shot, instead of a ParticleSystem each
+        Each bullet type can be given a budget, trails past it are skipped for the frame
+    */
+    class TrailRenderer {
+
+    public:
+        TrailRenderer(void);
+
+        // Call once there is an OpenGL context, the trail's geometry, texture, cycle and speed are shared by every bullet, drawn with the instanced shader variant for its type
+        void Init(ParticleSystem* trail, Shader* instanced_shader);
+
+        // Game time, bullets read it when they are shot
+        inline void setTime(double time) { time_ = time; };
+        inline double getTime(void) const { return time_; };
+
+        // Most trails of a bullet type drawn per frame
+        inline void setBudget(BulletType type, int budget) { budgets_[static_cast<int>(type)] = budget; };
+
+        // Queues the trail of a bullet at its current transform
+        void add(BulletType type, glm::vec3 position, float rotation, float scale, double start_time);
+
+        // Draws every queued trail
+        void Render(double current_time);
+
+    private:
+        ParticleBatch batch_;
+        float cycle_ = 1.0f;
+        float speed_ = 1.0f;
+        double time_ = 0.0;
+
+        int budgets_[BULLET_TYPE_COUNT];
+        int counts_[BULLET_TYPE_COUNT];
+
+    }; // class TrailRenderer
+
+} // namespace game
+
+#endif // TRAIL_RENDERER_H_
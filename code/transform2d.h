@@ -0,0 +1,79 @@
+#ifndef TRANSFORM2D_H_
+#define TRANSFORM2D_H_
+
+#include <cmath>
+#include <glm/glm.hpp>
+
+namespace game {
+
+    /*
+        Transform2D is a 2D affine transform, the top two rows of a 3x3 matrix, mapping (x, y) to
+        (a x + c y + tx, b x + d y + ty), with a depth carried alongside for the draw order
+        Objects only ever translate, rotate about z and scale in x and y, so this is all a mat4 chain of them holds,
+        in 6 floats instead of 16 and a quarter of the multiplies to compose
+        The rows are stored as the two vec4 the shaders read, (a, c, tx, depth) and (b, d, ty, 0)
+    */
+    struct Transform2D {
+        glm::vec4 row_x = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
+        glm::vec4 row_y = glm::vec4(0.0f, 1.0f, 0.0f, 0.0f);
+
+        // Scales, then rotates by angle radians, then translates, like translate * rotate * scale
+        static inline Transform2D Make(const glm::vec3& translation, float angle, const glm::vec2& scale)
+        {
+            float c = std::cos(angle);
+            float s = std::sin(angle);
+            Transform2D t;
+            t.row_x = glm::vec4(c * scale.x, -s * scale.y, translation.x, translation.z);
+            t.row_y = glm::vec4(s * scale.x, c * scale.y, translation.y, 0.0f);
+            return t;
+        }
+
+        // The x and y part of a matrix that keeps them apart from z, like a view matrix
+        static inline Transform2D FromMat4(const glm::mat4& m)
+        {
+            Transform2D t;
+            t.row_x = glm::vec4(m[0][0], m[1][0], m[3][0], m[3][2]);
+            t.row_y = glm::vec4(m[0][1], m[1][1], m[3][1], 0.0f);
+            return t;
+        }
+
+        // This transform applied after other, depths add up like z translations do
+        inline Transform2D operator*(const Transform2D& other) const
+        {
+            Transform2D t;
+            t.row_x = glm::vec4(
+                row_x.x * other.row_x.x + row_x.y * other.row_y.x,
+                row_x.x * other.row_x.y + row_x.y * other.row_y.y,
+                row_x.x * other.row_x.z + row_x.y * other.row_y.z + row_x.z,
+                row_x.w + other.row_x.w);
+            t.row_y = glm::vec4(
+                row_y.x * other.row_x.x + row_y.y * other.row_y.x,
+                row_y.x * other.row_x.y + row_y.y * other.row_y.y,
+                row_y.x * other.row_x.z + row_y.y * other.row_y.z + row_y.z,
+                0.0f);
+            return t;
+        }
+
+        // Undoes this transform, which has to be invertible, as any transform with a nonzero scale is
+        inline Transform2D Inverse(void) const
+        {
+            float inverse_determinant = 1.0f / (row_x.x * row_y.y - row_x.y * row_y.x);
+            float a = row_y.y * inverse_determinant;
+            float c = -row_x.y * inverse_determinant;
+            float b = -row_y.x * inverse_determinant;
+            float d = row_x.x * inverse_determinant;
+            Transform2D t;
+            t.row_x = glm::vec4(a, c, -(a * row_x.z + c * row_y.z), -row_x.w);
+            t.row_y = glm::vec4(b, d, -(b * row_x.z + d * row_y.z), 0.0f);
+            return t;
+        }
+
+        inline glm::vec2 Apply(const glm::vec2& point) const
+        {
+            return glm::vec2(row_x.x * point.x + row_x.y * point.y + row_x.z, row_y.x * point.x + row_y.y * point.y + row_y.z);
+        }
+    };
+
+} // namespace game
+
+#endif // TRANSFORM2D_H_
@@ -0,0 +1,118 @@
+#include <algorithm>
+
+#include "transform_stream.h"
+#include "gl_state.h"
+
+namespace game {
+
+    TransformStream::TransformStream(void)
+    {
+        for (int i = 0; i < TRANSFORM_STREAM_FRAMES; i++) {
+            fences_[i] = 0;
+        }
+    }
+
+
+    TransformStream::~TransformStream()
+    {
+        for (int i = 0; i < TRANSFORM_STREAM_FRAMES; i++) {
+            if (fences_[i] != 0) {
+                glDeleteSync(fences_[i]);
+            }
+        }
+        if (buffer_ != 0) {
+            if (mapped_ != nullptr) {
+                GLState::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+                glUnmapBuffer(GL_ARRAY_BUFFER);
+            }
+            GLState::DeleteBuffers(1, &buffer_);
+        }
+    }
+
+
+    void TransformStream::Init(void)
+    {
+        glGenBuffers(1, &buffer_);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+
+        if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) {
+            // one region per frame in flight, written through a mapping that stays valid while the GPU reads it
+            GLsizeiptr size = TRANSFORM_STREAM_FRAMES * TRANSFORM_STREAM_CAPACITY * sizeof(Transform2D);
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_ARRAY_BUFFER, size, NULL, flags);
+            mapped_ = static_cast<Transform2D*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+        } else {
+            glBufferData(GL_ARRAY_BUFFER, TRANSFORM_STREAM_CAPACITY * sizeof(Transform2D), NULL, GL_STREAM_DRAW);
+        }
+    }
+
+
+    void TransformStream::BeginFrame(void)
+    {
+        count_ = 0;
+        if (buffer_ == 0) {
+            return;
+        }
+
+        if (isPersistent()) {
+            region_ = (region_ + 1) % TRANSFORM_STREAM_FRAMES;
+            if (fences_[region_] != 0) {
+                // only blocks when the CPU is TRANSFORM_STREAM_FRAMES frames ahead of the GPU
+                glClientWaitSync(fences_[region_], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+                glDeleteSync(fences_[region_]);
+                fences_[region_] = 0;
+            }
+        } else {
+            // give last frame's storage to the driver instead of waiting for it
+            GLState::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+            glBufferData(GL_ARRAY_BUFFER, TRANSFORM_STREAM_CAPACITY * sizeof(Transform2D), NULL, GL_STREAM_DRAW);
+        }
+    }
+
+
+    void TransformStream::EndFrame(void)
+    {
+        if (isPersistent()) {
+            fences_[region_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+    }
+
+
+    bool TransformStream::Bind(GLint location, const Transform2D* transforms, int count)
+    {
+        if (count_ + count > TRANSFORM_STREAM_CAPACITY) {
+            return false;
+        }
+
+        int slot = count_;
+        count_ += count;
+        GLState::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+        if (isPersistent()) {
+            slot += region_ * TRANSFORM_STREAM_CAPACITY;
+            std::copy(transforms, transforms + count, mapped_ + slot);
+        } else {
+            GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+            void* range = glMapBufferRange(GL_ARRAY_BUFFER, slot * sizeof(Transform2D), count * sizeof(Transform2D), access);
+            std::copy(transforms, transforms + count, static_cast<Transform2D*>(range));
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+
+        // a mat2x4 attribute takes one location per row, advanced once per instance
+        for (int column = 0; column < 2; column++) {
+            glVertexAttribPointer(location + column, 4, GL_FLOAT, GL_FALSE, sizeof(Transform2D), (void*)(slot * sizeof(Transform2D) + column * sizeof(glm::vec4)));
+            glEnableVertexAttribArray(location + column);
+            glVertexAttribDivisor(location + column, 1);
+        }
+        return true;
+    }
+
+
+    void TransformStream::Unbind(GLint location)
+    {
+        for (int column = 0; column < 2; column++) {
+            glVertexAttribDivisor(location + column, 0);
+            glDisableVertexAttribArray(location + column);
+        }
+    }
+
+} // namespace game
@@ -0,0 +1,56 @@
+#ifndef TRANSFORM_STREAM_H_
+#define TRANSFORM_STREAM_H_
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include "config.h"
+#include "transform2d.h"
+
+namespace game {
+
+    /*
+        TransformStream is a ring of per-instance transforms that shaders read as a mat2x4 attribute, the two rows of a Transform2D
+        An instanced draw writes the transforms of all its instances to the next slots at once and draws them in one call,
+        draws of a single object set the attribute as a constant instead, see Shader::SetTransform
+        With ARB_buffer_storage the ring is persistently mapped and split into TRANSFORM_STREAM_FRAMES regions,
+        one per frame in flight, each fenced so a region is only rewritten once the GPU is done with it
+        Without it there is a single region, orphaned at the start of every frame; each batch maps only the slots it writes, unsynchronized,
+        since no draw of the frame reads them yet
+    */
+    class TransformStream {
+
+    public:
+        TransformStream(void);
+        ~TransformStream();
+
+        // Call once there is an OpenGL context, frames of a stream never initialized do nothing
+        void Init(void);
+
+        // Moves to the next region, waiting for the GPU if it still reads it
+        void BeginFrame(void);
+
+        // Fences the region written this frame
+        void EndFrame(void);
+
+        // Writes count transforms and points the mat2x4 attribute at location to them, one per instance of the next draw
+        // Returns false, binding nothing, once the frame's slots are used up
+        bool Bind(GLint location, const Transform2D* transforms, int count);
+
+        // Disables the attribute again after the draw, so later draws set it as a constant
+        void Unbind(GLint location);
+
+        inline bool isPersistent(void) const { return mapped_ != nullptr; };
+
+    private:
+        GLuint buffer_ = 0;
+        Transform2D* mapped_ = nullptr;
+
+        int region_ = 0;
+        int count_ = 0;             // slots written this frame
+        GLsync fences_[TRANSFORM_STREAM_FRAMES];
+
+    }; // class TransformStream
+
+} // namespace game
+
+#endif // TRANSFORM_STREAM_H_
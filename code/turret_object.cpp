@@ -1,4 +1,6 @@
 #include "turret_object.h"
+#include "gl_state.h"
+#include "gl_stats.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace game {
@@ -9,8 +11,8 @@ namespace game {
             type(type), parent(parent), parent_offset(parent_offset)
     {
         object_type = ObjectType::Turret;
-        // set the position and rotation of the turret object to match the parent object
-        SetPosition(parent->GetPosition());
+        // set the position and rotation of the turret object to match the parent object, at its offset
+        SetPosition(parent->GetPosition() + parent_offset);
         SetRotation(parent->GetRotation());
         parent_rotation_offset = parent->GetRotation();
 
@@ -73,47 +75,33 @@ namespace game {
     }
 
     // hierarchically render the turret object
-    void TurretObject::Render(glm::mat4 view_matrix, double current_time) {
-        view_matrix_ = view_matrix;
+    void TurretObject::Render(double current_time) {
+        GL_STATS_SCOPE("TurretObject::Render");
 
         // Set up the shader
         shader_->Enable();
 
-        // Set up the view matrix
-        shader_->SetUniformMat4("view_matrix", view_matrix);
-
-        // Setup the scaling matrix for the shader
-        glm::mat4 scaling_matrix = glm::scale(glm::mat4(1.0f), glm::vec3(scale_.x, scale_.y, 1.0));
 
-        // Get the parent's position and rotation
+        // Get the parent's position
         glm::vec3 parent_position = parent->GetPosition();
-        float parent_rotation = parent->GetRotation();
-
-        // Translate the turret to the parent's position
-        glm::mat4 translation_matrix = glm::translate(glm::mat4(1.0f), parent_position + parent_offset);
-
-        // Rotate the turret based on the parent's rotation
-        // glm::mat4 rotation_matrix = glm::rotate(glm::mat4(1.0f), parent_rotation + parent_rotation_offset, glm::vec3(0.0, 0.0, 1.0));
 
-        // Apply the turret's own rotation
-        glm::mat4 turret_rotation_matrix = glm::rotate(glm::mat4(1.0f), angle_, glm::vec3(0.0, 0.0, 1.0));
-
-        // Combine the transformations
-        glm::mat4 transformation_matrix = translation_matrix * turret_rotation_matrix * scaling_matrix;
-        shader_->SetUniformMat4("transformation_matrix", transformation_matrix);
+        // Translate the turret to the parent's position, with the turret's own rotation and scale
+        // (it does not turn with its parent)
+        Transform2D transformation = Transform2D::Make(parent_position + parent_offset, angle_, scale_);
+        shader_->SetTransform(transformation);
 
         // Set up the geometry
         geometry_->SetGeometry(shader_->GetShaderProgram());
 
         // Bind the entity's texture
-        glBindTexture(GL_TEXTURE_2D, texture_);
+        GLState::BindTexture(texture_);
 
         // Draw the entity
-        glDrawElements(GL_TRIANGLES, geometry_->GetSize(), GL_UNSIGNED_INT, 0);
+        GLStats::DrawElements(GL_TRIANGLES, geometry_->GetSize(), GL_UNSIGNED_INT, 0);
 
         // Render all child objects
         for (auto child : child_objects_) {
-            child->Render(view_matrix, current_time);
+            child->Render(current_time);
         }
     }
 
@@ -124,14 +112,9 @@ namespace game {
             return;
         }
 
-        // transform the cursor position to the world space using the view matrix
-        glm::vec4 cursor_position_view = glm::vec4(cursor_position.x, cursor_position.y, 0.0f, 1.0f);
-        glm::vec4 cursor_position_world = glm::inverse(view_matrix_) * cursor_position_view;
-        glm::vec2 cursor_position_new = glm::vec2(cursor_position_world.x, cursor_position_world.y);
-
         // get the angle between the cursor and the turret
         glm::vec2 turret_position = glm::vec2(GetPosition().x, GetPosition().y);
-        glm::vec2 direction = cursor_position_new - turret_position;
+        glm::vec2 direction = cursor_position - turret_position;
 
         float target_angle = glm::atan(direction.y, direction.x) + angle_offset;
         if (target_angle < 0) {
@@ -158,26 +141,21 @@ namespace game {
     }
 
     // called by the player object to fire the turret
-    BulletObject* TurretObject::Fire()
+    bool TurretObject::Fire(std::vector<GameObject*>& bullets)
     {
-        // if the fire cooldown timer is still running, return nullptr
+        // if the fire cooldown timer is still running, do nothing
         if (!fire_cooldown_timer->timesUp())
-            return nullptr;
+            return false;
 
         // reset the timer
         fire_cooldown_timer->setTime(fire_cooldown);
 
-        // deep copy the bullet object
-        auto* new_bullet = new BulletObject(*bullet);
-
         // calculate bullet position, should be at the tip of the turret
         glm::vec3 bullet_position = GetPosition() + glm::vec3(glm::cos(angle_), glm::sin(angle_), 0.0f) * hitbox_radius;
         bullet_position.z = 0.0f;
-        new_bullet->Shoot(bullet_position, GetBearing(), parent);
-        // new_bullet->SetScale(10.0);
-        new_bullet->SetRotation(angle_ - glm::pi<float>() / 2.0f);
+        bullet->Fire(bullet_position, GetBearing(), bullet->GetScale(), parent, &bullets);
 
-        return new_bullet;
+        return true;
     }
 
     // set the angle offset of the turret
@@ -21,15 +21,16 @@ namespace game
         TurretObject(const TurretObject& other);
 
         void Update(double delta_time) override;
-        void Render(glm::mat4 view_matrix, double current_time) override;
+        void Render(double current_time) override;
 
         // turret specific functions
+        // turns towards the cursor, in world space
         void Control(const glm::vec2 cursor_position, double delta_time);
 
         // setters
         void SetBullet(BulletObject* bullet) { this->bullet = bullet; }
         inline void SetFireCooldown(float cooldown) { fire_cooldown = cooldown; }
-        BulletObject* Fire();
+        bool Fire(std::vector<GameObject*>& bullets);
         void SetAngleOffset(float offset) { angle_offset = offset; }
         void SetParentRotationOffset(float offset);
         void SetHitbox(float hitbox) { hitbox_radius = hitbox; }
@@ -43,7 +44,6 @@ namespace game
 
     private:
         // turret control variables
-        glm::mat4 view_matrix_ = glm::mat4(1.0f);  // view matrix for rendering the turret
         float rotation_speed = 1.0f;  // speed at which the turret rotates
         glm::vec3 parent_offset = glm::vec3(0.0f, 0.0f, -1.0f);  // relative to the parent object's origin
         float parent_rotation_offset = glm::pi<float>() / 2.0f;  // offset to the parent's rotation
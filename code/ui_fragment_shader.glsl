@@ -1,8 +1,6 @@
 // Source code of fragment shader
 #version 130
 
-#define HEALTH_BAR 1000
-
 // Attributes passed from the vertex shader
 in vec4 color_interp;
 in vec2 uv_interp;
@@ -12,8 +10,9 @@ in vec4 vertex_pos;
 uniform sampler2D onetex;
 
 // Uniform
-uniform int object_type;
-uniform float health;
+uniform float health; // Health bar only
+
+// Element, a #define of the variant ShaderCache built: HEALTH_BAR, or a textured sprite without it
 
 void main()
 {
@@ -21,22 +20,17 @@ void main()
     //vec4 color = texture2D(onetex, uv_interp);
     //vec4 color = color_interp;
 
-    vec4 color = vec4(0.0, 0.0, 1.0, 1.0);
-
-    switch(object_type){
-    case HEALTH_BAR:
-        if (vertex_pos.x < (10 * health)){
-            color = vec4(0.184, 0.49, 0.165, 1.0);
-        } else {
-            color = vec4(1.0, 0.0, 0.0, 1.0);
-        }
-        break;
+    vec4 color;
 
-    default:
-        color = texture2D(onetex, uv_interp);
-        break;
+#ifdef HEALTH_BAR
+    if (vertex_pos.x < (10 * health)){
+        color = vec4(0.184, 0.49, 0.165, 1.0);
+    } else {
+        color = vec4(1.0, 0.0, 0.0, 1.0);
     }
-    
+#else
+    color = texture2D(onetex, uv_interp);
+#endif
 
     // Assign color to fragment
     gl_FragColor = vec4(color.r, color.g, color.b, color.a);
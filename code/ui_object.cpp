@@ -13,11 +13,11 @@ namespace game {
 		delete arrow;
 	};
 
-	void UIObject::setUp(Geometry* health_bar_geom, GLuint arrow_texture, Shader* arrow_shader, GameObject** win_1, GameObject** win_2, GameObject** win_3, GameObject** win_4) {
-		health_bar = new HealthBar(health_bar_position, health_bar_geom, getShader(), getTexture(), player_);
+	void UIObject::setUp(Geometry* health_bar_geom, Shader* health_bar_shader, GLuint arrow_texture, Shader* arrow_shader, const KdTree* win_tree) {
+		health_bar = new HealthBar(health_bar_position, health_bar_geom, health_bar_shader, getTexture(), player_);
 		health_bar->SetScale(1.0f);
 
-		arrow = new Arrow(arrow_position, getGeometry(), getShader(), arrow_texture, player_, win_1, win_2, win_3, win_4);
+		arrow = new Arrow(arrow_position, getGeometry(), arrow_shader, arrow_texture, player_, win_tree);
 		arrow->SetScale(4.0f);
 	}
 
@@ -31,9 +31,9 @@ namespace game {
 		arrow->Update(delta_time);
 	}
 
-	void UIObject::Render(glm::mat4 view_matrix, double current_time) {
-		health_bar->Render(view_matrix, current_time);
-		arrow->Render(view_matrix, current_time);
+	void UIObject::Render(double current_time) {
+		health_bar->Render(current_time);
+		arrow->Render(current_time);
 	}
 
 } // namespace game
\ No newline at end of file
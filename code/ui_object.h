@@ -15,12 +15,12 @@ namespace game {
 		UIObject(const glm::vec3& position, Geometry* geom, Shader* shader, GLuint texture, GameObject* player);
 		~UIObject();
 
-		void setUp(Geometry* health_bar_geom, GLuint arrow_texture, Shader* arrow_shader,
-			GameObject** win_1, GameObject** win_2, GameObject** win_3, GameObject** win_4);
+		void setUp(Geometry* health_bar_geom, Shader* health_bar_shader, GLuint arrow_texture, Shader* arrow_shader,
+			const KdTree* win_tree);
 
 		void Update(double delta_time) override;
 
-		void Render(glm::mat4 view_matrix, double current_time) override;
+		void Render(double current_time) override;
 
 	private:
 		GameObject* player_;
@@ -1,14 +1,17 @@
 // Source code of vertex shader
 #version 130
+#extension GL_ARB_uniform_buffer_object : require
 
 // Vertex buffer
 in vec2 vertex;
 in vec3 color;
 in vec2 uv;
+in mat2x4 transformation; // Per-object 2D affine transform, its two rows from the transform stream
 
-// Uniform (global) buffer
-uniform mat4 transformation_matrix;
-uniform mat4 view_matrix;
+// Per-frame camera, shared by every shader
+layout(std140) uniform Camera {
+    mat4 view_matrix;
+};
 
 // Attributes forwarded to the fragment shader
 out vec4 color_interp;
@@ -19,7 +22,9 @@ void main()
 {
     // Transform vertex
     vertex_pos = vec4(vertex, 0.0, 1.0);
-    gl_Position = view_matrix * transformation_matrix * vertex_pos;
+    // rows are (a, c, tx, depth) and (b, d, ty, 0)
+    vec4 world_pos = vec4(dot(transformation[0].xyz, vertex_pos.xyw), dot(transformation[1].xyz, vertex_pos.xyw), transformation[0].w, 1.0);
+    gl_Position = view_matrix * world_pos;
     
     // Pass attributes to fragment shader
     color_interp = vec4(1.0, 0.0, 0.0, 1.0);